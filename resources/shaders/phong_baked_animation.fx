@@ -0,0 +1,150 @@
+[vertex]
+#version 330 core
+
+#define MAX_INSTANCES_PER_DRAW 32
+#define TEXELS_PER_BONE 3
+
+layout (location = 0) in vec3 attrPosition;
+layout (location = 1) in vec3 attrNormal;
+layout (location = 2) in vec3 attrTangent;
+layout (location = 3) in vec3 attrBitangent;
+layout (location = 4) in vec2 attrUV;
+layout (location = 5) in ivec4 attrBonesIds;
+layout (location = 6) in vec4 attrBonesWeights;
+
+struct Scene {
+	mat4 viewTransform;
+	mat4 projectionTransform;
+};
+
+struct BakedAnimation {
+	sampler2D bonesTexture;
+	int framesCount;
+	float framesPerSecond;
+	bool isLooped;
+	float time;
+};
+
+struct Instances {
+	mat4 transforms[MAX_INSTANCES_PER_DRAW];
+	float timeOffsets[MAX_INSTANCES_PER_DRAW];
+};
+
+uniform Scene scene;
+uniform BakedAnimation bakedAnimation;
+uniform Instances instances;
+
+out vec3 position;
+out vec2 uv;
+out mat3 TBN;
+
+mat4 fetchBoneTransform(int boneId, int frame) {
+	int column = boneId * TEXELS_PER_BONE;
+
+	vec4 row0 = texelFetch(bakedAnimation.bonesTexture, ivec2(column, frame), 0);
+	vec4 row1 = texelFetch(bakedAnimation.bonesTexture, ivec2(column + 1, frame), 0);
+	vec4 row2 = texelFetch(bakedAnimation.bonesTexture, ivec2(column + 2, frame), 0);
+
+	return transpose(mat4(row0, row1, row2, vec4(0.0, 0.0, 0.0, 1.0)));
+}
+
+mat4 getSkinningTransform(int frame) {
+	return fetchBoneTransform(attrBonesIds[0], frame) * attrBonesWeights[0] +
+		fetchBoneTransform(attrBonesIds[1], frame) * attrBonesWeights[1] +
+		fetchBoneTransform(attrBonesIds[2], frame) * attrBonesWeights[2] +
+		fetchBoneTransform(attrBonesIds[3], frame) * attrBonesWeights[3];
+}
+
+void main() {
+	float time = bakedAnimation.time + instances.timeOffsets[gl_InstanceID];
+	float frame = time * bakedAnimation.framesPerSecond;
+
+	int currentFrame;
+	int nextFrame;
+
+	if (bakedAnimation.isLooped) {
+		frame = mod(frame, float(bakedAnimation.framesCount));
+
+		currentFrame = int(floor(frame));
+		nextFrame = (currentFrame + 1) % bakedAnimation.framesCount;
+	}
+	else {
+		frame = clamp(frame, 0.0, float(bakedAnimation.framesCount - 1));
+
+		currentFrame = int(floor(frame));
+		nextFrame = min(currentFrame + 1, bakedAnimation.framesCount - 1);
+	}
+
+	// Blend neighbouring frames, so the baking rate doesn't limit the playback smoothness
+	float frameProgress = fract(frame);
+	mat4 skinningTransform = getSkinningTransform(currentFrame) * (1.0 - frameProgress) + 
+		getSkinningTransform(nextFrame) * frameProgress;
+	mat4 localToWorld = instances.transforms[gl_InstanceID] * skinningTransform;
+
+	vec4 worldPosition = localToWorld * vec4(attrPosition, 1.0);
+	mat3 normalTransform = mat3(localToWorld);
+
+	vec3 T = normalize(normalTransform * attrTangent);
+	vec3 B = normalize(normalTransform * attrBitangent);
+	vec3 N = normalize(normalTransform * attrNormal);
+
+	position = worldPosition.xyz;
+	uv = attrUV;
+	TBN = mat3(T, B, N);
+
+	gl_Position = scene.projectionTransform * scene.viewTransform * worldPosition;
+}
+[/vertex]
+
+[fragment]
+#version 330 core
+
+layout (location = 0) out vec4 gBufferAlbedo;
+layout (location = 1) out vec4 gBufferNormal;
+layout (location = 2) out vec4 gBufferPosition;
+layout (location = 3) out vec4 gBufferUV;
+
+struct Material {
+	vec3 diffuseColor;
+	vec3 specularColor;
+	float specularFactor;
+	vec3 emissiveColor;
+
+	bool useDiffuseTexture;
+	sampler2D diffuseTexture;
+
+	bool useSpecularTexture;
+	sampler2D specularTexture;
+
+	bool useNormalMapping;
+	sampler2D normalMap;
+};
+
+uniform Material material;
+
+in vec3 position;
+in vec2 uv;
+in mat3 TBN;
+
+void main() {
+	vec3 diffuseColor = material.diffuseColor;
+
+	if (material.useDiffuseTexture)
+		diffuseColor *= texture(material.diffuseTexture, uv).rgb;
+
+	float specularIntensity = material.specularColor.r;
+
+	if (material.useSpecularTexture)
+		specularIntensity *= texture(material.specularTexture, uv).r;
+
+	vec3 normal = TBN[2];
+
+	if (material.useNormalMapping)
+		normal = normalize(TBN * (texture(material.normalMap, uv).rgb * 2.0 - 1.0));
+
+	gBufferAlbedo = vec4(diffuseColor + material.emissiveColor, specularIntensity);
+	gBufferNormal = vec4(normalize(normal), material.specularFactor);
+	gBufferPosition = vec4(position, 1.0);
+	gBufferUV = vec4(uv, 0.0, 1.0);
+}
+[/fragment]
\ No newline at end of file
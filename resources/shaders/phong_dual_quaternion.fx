@@ -0,0 +1,155 @@
+[vertex]
+#version 330 core
+
+#define MAX_BONES_COUNT 128
+
+layout (location = 0) in vec3 attrPosition;
+layout (location = 1) in vec3 attrNormal;
+layout (location = 2) in vec3 attrTangent;
+layout (location = 3) in vec3 attrBitangent;
+layout (location = 4) in vec2 attrUV;
+layout (location = 5) in ivec4 attrBonesIds;
+layout (location = 6) in vec4 attrBonesWeights;
+
+struct Scene {
+	mat4 viewTransform;
+	mat4 projectionTransform;
+};
+
+struct Transform {
+	mat4 localToWorld;
+};
+
+struct Animation {
+	bool isAnimated;
+
+	// Real and dual parts of every bone transform, xyzw
+	vec4 dualQuaternions[MAX_BONES_COUNT * 2];
+};
+
+uniform Scene scene;
+uniform Transform transform;
+uniform Animation animation;
+
+out vec3 position;
+out vec2 uv;
+out mat3 TBN;
+
+// Dual quaternion linear blending
+mat2x4 getSkinningDualQuaternion() {
+	vec4 pivotReal = animation.dualQuaternions[attrBonesIds[0] * 2];
+
+	vec4 real = vec4(0.0);
+	vec4 dual = vec4(0.0);
+
+	for (int i = 0; i < 4; i++) {
+		vec4 boneReal = animation.dualQuaternions[attrBonesIds[i] * 2];
+		vec4 boneDual = animation.dualQuaternions[attrBonesIds[i] * 2 + 1];
+
+		// q and -q are the same rotation, blend all of them in one hemisphere
+		float weight = attrBonesWeights[i] * sign(dot(pivotReal, boneReal) + 1e-6);
+
+		real += boneReal * weight;
+		dual += boneDual * weight;
+	}
+
+	float realLength = length(real);
+
+	return mat2x4(real / realLength, dual / realLength);
+}
+
+vec3 rotate(vec4 q, vec3 v) {
+	return v + 2.0 * cross(q.xyz, cross(q.xyz, v) + q.w * v);
+}
+
+vec3 transformPosition(mat2x4 dq, vec3 v) {
+	vec4 real = dq[0];
+	vec4 dual = dq[1];
+
+	vec3 translation = 2.0 * (real.w * dual.xyz - dual.w * real.xyz + cross(real.xyz, dual.xyz));
+
+	return rotate(real, v) + translation;
+}
+
+void main() {
+	vec3 localPosition = attrPosition;
+	vec3 localNormal = attrNormal;
+	vec3 localTangent = attrTangent;
+	vec3 localBitangent = attrBitangent;
+
+	if (animation.isAnimated) {
+		mat2x4 skinningTransform = getSkinningDualQuaternion();
+
+		localPosition = transformPosition(skinningTransform, attrPosition);
+		localNormal = rotate(skinningTransform[0], attrNormal);
+		localTangent = rotate(skinningTransform[0], attrTangent);
+		localBitangent = rotate(skinningTransform[0], attrBitangent);
+	}
+
+	vec4 worldPosition = transform.localToWorld * vec4(localPosition, 1.0);
+	mat3 normalTransform = mat3(transpose(inverse(transform.localToWorld)));
+
+	vec3 T = normalize(normalTransform * localTangent);
+	vec3 B = normalize(normalTransform * localBitangent);
+	vec3 N = normalize(normalTransform * localNormal);
+
+	position = worldPosition.xyz;
+	uv = attrUV;
+	TBN = mat3(T, B, N);
+
+	gl_Position = scene.projectionTransform * scene.viewTransform * worldPosition;
+}
+[/vertex]
+
+[fragment]
+#version 330 core
+
+layout (location = 0) out vec4 gBufferAlbedo;
+layout (location = 1) out vec4 gBufferNormal;
+layout (location = 2) out vec4 gBufferPosition;
+layout (location = 3) out vec4 gBufferUV;
+
+struct Material {
+	vec3 diffuseColor;
+	vec3 specularColor;
+	float specularFactor;
+	vec3 emissiveColor;
+
+	bool useDiffuseTexture;
+	sampler2D diffuseTexture;
+
+	bool useSpecularTexture;
+	sampler2D specularTexture;
+
+	bool useNormalMapping;
+	sampler2D normalMap;
+};
+
+uniform Material material;
+
+in vec3 position;
+in vec2 uv;
+in mat3 TBN;
+
+void main() {
+	vec3 diffuseColor = material.diffuseColor;
+
+	if (material.useDiffuseTexture)
+		diffuseColor *= texture(material.diffuseTexture, uv).rgb;
+
+	float specularIntensity = material.specularColor.r;
+
+	if (material.useSpecularTexture)
+		specularIntensity *= texture(material.specularTexture, uv).r;
+
+	vec3 normal = TBN[2];
+
+	if (material.useNormalMapping)
+		normal = normalize(TBN * (texture(material.normalMap, uv).rgb * 2.0 - 1.0));
+
+	gBufferAlbedo = vec4(diffuseColor + material.emissiveColor, specularIntensity);
+	gBufferNormal = vec4(normalize(normal), material.specularFactor);
+	gBufferPosition = vec4(position, 1.0);
+	gBufferUV = vec4(uv, 0.0, 1.0);
+}
+[/fragment]
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include "Benchmark.h"
+
+#include <cstdio>
+
+Benchmark::Benchmark(double minCaseDuration)
+	: m_minCaseDuration(minCaseDuration),
+	m_checksum(0)
+{
+}
+
+Benchmark::~Benchmark()
+{
+}
+
+void Benchmark::beginGroup(const std::string& name)
+{
+	m_groupName = name;
+}
+
+void Benchmark::printResults() const
+{
+	std::printf("%-64s %14s %16s\n", "Case", "ns/test", "tests/s");
+
+	for (const Result& result : m_results) {
+		std::printf("%-64s %14.2f %16.0f\n", result.name.c_str(),
+			result.getNanosecondsPerTest(), result.getTestsPerSecond());
+	}
+
+	std::printf("\nChecksum: %zu\n", m_checksum);
+}
+
+const std::vector<Benchmark::Result>& Benchmark::getResults() const
+{
+	return m_results;
+}
+
+void Benchmark::addResult(const std::string& name, size_t testsCount, double duration)
+{
+	std::string fullName = m_groupName.empty() ? name : m_groupName + " / " + name;
+
+	m_results.push_back({ fullName, testsCount, duration });
+}
+
+double Benchmark::Result::getNanosecondsPerTest() const
+{
+	return duration * 1e9 / static_cast<double>(testsCount);
+}
+
+double Benchmark::Result::getTestsPerSecond() const
+{
+	return static_cast<double>(testsCount) / duration;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+
+// Measures throughput of the repeated tests and prints the results table.
+// Every case is repeated until it runs long enough to hide the timer resolution
+class Benchmark {
+public:
+	struct Result {
+		std::string name;
+
+		size_t testsCount;
+		double duration;
+
+		double getNanosecondsPerTest() const;
+		double getTestsPerSecond() const;
+	};
+
+public:
+	Benchmark(double minCaseDuration);
+	~Benchmark();
+
+	// Iteration performs testsPerIteration tests and returns a value depending on all of them,
+	// so the compiler can't throw the work away
+	template<class Iteration>
+	void run(const std::string& name, size_t testsPerIteration, Iteration iteration);
+
+	void beginGroup(const std::string& name);
+	void printResults() const;
+
+	const std::vector<Result>& getResults() const;
+
+private:
+	void addResult(const std::string& name, size_t testsCount, double duration);
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+private:
+	static const size_t WARMUP_ITERATIONS_COUNT = 4;
+
+private:
+	double m_minCaseDuration;
+
+	std::string m_groupName;
+	std::vector<Result> m_results;
+
+	// Sum of the iterations results, printed in the end to keep the tests alive
+	size_t m_checksum;
+};
+
+template<class Iteration>
+inline void Benchmark::run(const std::string& name, size_t testsPerIteration, Iteration iteration)
+{
+	for (size_t warmupIndex = 0; warmupIndex < WARMUP_ITERATIONS_COUNT; warmupIndex++)
+		m_checksum += static_cast<size_t>(iteration());
+
+	size_t iterationsCount = 0;
+	double duration = 0.0;
+
+	Clock::time_point startTime = Clock::now();
+
+	do {
+		m_checksum += static_cast<size_t>(iteration());
+		iterationsCount++;
+
+		duration = std::chrono::duration<double>(Clock::now() - startTime).count();
+	} while (duration < m_minCaseDuration);
+
+	addResult(name, iterationsCount * testsPerIteration, duration);
+}
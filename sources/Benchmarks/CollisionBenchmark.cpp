@@ -0,0 +1,667 @@
+#include "Benchmark.h"
+
+#include <Engine/Components/Math/types.h>
+#include <Engine/Components/Math/Geometry/Surfaces/Triangle.h>
+#include <Engine/Components/Physics/Ray.h>
+#include <Engine/Components/Physics/Colliders/AABB.h>
+#include <Engine/Components/Physics/Colliders/OBB.h>
+#include <Engine/Components/Physics/Colliders/Sphere.h>
+#include <Engine/Components/Physics/Colliders/Capsule.h>
+#include <Engine/Components/Physics/Colliders/CollidersBatch.h>
+#include <Engine/Components/Physics/TriangleMeshHierarchy.h>
+#include <Engine/Components/Physics/Broadphase/Broadphase.h>
+
+#include <random>
+#include <cstring>
+#include <cstdio>
+
+// Collision primitives and broadphase throughput, doesn't need the window or the graphics context.
+// Pass --quick for a short run
+static const double CASE_DURATION = 0.5;
+static const double QUICK_CASE_DURATION = 0.05;
+
+// Colliders are scattered in the cube of this size around the origin
+static const float WORLD_SIZE = 20.0f;
+
+static const float MIN_COLLIDER_SIZE = 0.25f;
+static const float MAX_COLLIDER_SIZE = 2.0f;
+
+// Number of the prepared pairs every iteration goes through, the data fits into the cache
+static const size_t PAIRS_COUNT = 1024;
+
+using RandomEngine = std::mt19937;
+
+static float randomFloat(RandomEngine& random, float min, float max)
+{
+	return std::uniform_real_distribution<float>(min, max)(random);
+}
+
+static vector3 randomPosition(RandomEngine& random, float extent)
+{
+	return vector3(randomFloat(random, -extent, extent), randomFloat(random, -extent, extent),
+		randomFloat(random, -extent, extent));
+}
+
+static vector3 randomDirection(RandomEngine& random)
+{
+	vector3 direction;
+
+	do {
+		direction = randomPosition(random, 1.0f);
+	} while (glm::dot(direction, direction) < 0.01f);
+
+	return glm::normalize(direction);
+}
+
+static quaternion randomOrientation(RandomEngine& random)
+{
+	return glm::angleAxis(randomFloat(random, 0.0f, glm::two_pi<float>()), randomDirection(random));
+}
+
+static OBB createBox(const vector3& center, const vector3& size, const quaternion& orientation)
+{
+	matrix3 basis = glm::mat3_cast(orientation);
+	vector3 origin = center - basis * (size * 0.5f);
+
+	return OBB(origin, origin + basis[0] * size.x, origin + basis[1] * size.y, origin + basis[2] * size.z);
+}
+
+static OBB randomBox(RandomEngine& random, float extent)
+{
+	vector3 size(randomFloat(random, MIN_COLLIDER_SIZE, MAX_COLLIDER_SIZE),
+		randomFloat(random, MIN_COLLIDER_SIZE, MAX_COLLIDER_SIZE),
+		randomFloat(random, MIN_COLLIDER_SIZE, MAX_COLLIDER_SIZE));
+
+	return createBox(randomPosition(random, extent), size, randomOrientation(random));
+}
+
+static AABB randomBounds(RandomEngine& random, float extent)
+{
+	vector3 center = randomPosition(random, extent);
+	vector3 halfSize = vector3(randomFloat(random, MIN_COLLIDER_SIZE, MAX_COLLIDER_SIZE)) * 0.5f;
+
+	return AABB(center - halfSize, center + halfSize);
+}
+
+// Ray from the random point of the world towards the random point near the target,
+// the spread controls the part of the rays that hit
+static Ray randomRayTowards(RandomEngine& random, const vector3& target, float spread)
+{
+	vector3 origin = randomPosition(random, WORLD_SIZE * 0.5f);
+	vector3 direction = target + randomPosition(random, spread) - origin;
+
+	if (glm::dot(direction, direction) < 1e-6f)
+		direction = vector3(1.0f, 0.0f, 0.0f);
+
+	return Ray(origin, glm::normalize(direction));
+}
+
+static void benchmarkBoxes(Benchmark& benchmark, RandomEngine& random)
+{
+	benchmark.beginGroup("OBB");
+
+	std::vector<OBB> firstBoxes;
+	std::vector<OBB> secondBoxes;
+
+	// Random pairs are mostly separated by one of the first axes
+	for (size_t pairIndex = 0; pairIndex < PAIRS_COUNT; pairIndex++) {
+		firstBoxes.push_back(randomBox(random, WORLD_SIZE * 0.05f));
+		secondBoxes.push_back(randomBox(random, WORLD_SIZE * 0.05f));
+	}
+
+	benchmark.run("intersects(OBB), random", PAIRS_COUNT, [&]() {
+		size_t hitsCount = 0;
+		Intersection intersection;
+
+		for (size_t pairIndex = 0; pairIndex < PAIRS_COUNT; pairIndex++)
+			hitsCount += firstBoxes[pairIndex].intersects(secondBoxes[pairIndex], intersection);
+
+		return hitsCount;
+	});
+
+	// Intersecting boxes are the worst case, all the 15 axes are tested to find the minimal depth
+	std::vector<OBB> overlappingBoxes;
+
+	for (size_t pairIndex = 0; pairIndex < PAIRS_COUNT; pairIndex++) {
+		const OBB& box = firstBoxes[pairIndex];
+		overlappingBoxes.push_back(createBox(box.getCenter() + randomPosition(random, MIN_COLLIDER_SIZE * 0.25f),
+			vector3(MAX_COLLIDER_SIZE), randomOrientation(random)));
+	}
+
+	benchmark.run("intersects(OBB), overlapping", PAIRS_COUNT, [&]() {
+		size_t hitsCount = 0;
+		Intersection intersection;
+
+		for (size_t pairIndex = 0; pairIndex < PAIRS_COUNT; pairIndex++)
+			hitsCount += firstBoxes[pairIndex].intersects(overlappingBoxes[pairIndex], intersection);
+
+		return hitsCount;
+	});
+
+	benchmark.run("isSeparatedBy(OBB, cached feature), random", PAIRS_COUNT, [&]() {
+		size_t separationsCount = 0;
+
+		// Features ids go through all the 15 separating axes
+		for (size_t pairIndex = 0; pairIndex < PAIRS_COUNT; pairIndex++)
+			separationsCount += firstBoxes[pairIndex].isSeparatedBy(secondBoxes[pairIndex], pairIndex % 15);
+
+		return separationsCount;
+	});
+
+	std::vector<vector3> displacements;
+
+	for (size_t pairIndex = 0; pairIndex < PAIRS_COUNT; pairIndex++)
+		displacements.push_back(secondBoxes[pairIndex].getCenter() - firstBoxes[pairIndex].getCenter());
+
+	benchmark.run("sweep(OBB), towards each other", PAIRS_COUNT, [&]() {
+		size_t hitsCount = 0;
+		float timeOfImpact;
+		vector3 normal;
+
+		for (size_t pairIndex = 0; pairIndex < PAIRS_COUNT; pairIndex++)
+			hitsCount += firstBoxes[pairIndex].sweep(displacements[pairIndex], secondBoxes[pairIndex], timeOfImpact, normal);
+
+		return hitsCount;
+	});
+
+	std::vector<Ray> randomRays;
+	std::vector<Ray> hittingRays;
+
+	for (size_t pairIndex = 0; pairIndex < PAIRS_COUNT; pairIndex++) {
+		vector3 center = firstBoxes[pairIndex].getCenter();
+
+		randomRays.push_back(randomRayTowards(random, center, WORLD_SIZE * 0.25f));
+		hittingRays.push_back(randomRayTowards(random, center, 0.0f));
+	}
+
+	benchmark.run("intersects(Ray), random", PAIRS_COUNT, [&]() {
+		size_t hitsCount = 0;
+		float distance;
+
+		for (size_t pairIndex = 0; pairIndex < PAIRS_COUNT; pairIndex++)
+			hitsCount += firstBoxes[pairIndex].intersects(randomRays[pairIndex], distance);
+
+		return hitsCount;
+	});
+
+	benchmark.run("intersects(Ray), hitting", PAIRS_COUNT, [&]() {
+		size_t hitsCount = 0;
+		float distance;
+
+		for (size_t pairIndex = 0; pairIndex < PAIRS_COUNT; pairIndex++)
+			hitsCount += firstBoxes[pairIndex].intersects(hittingRays[pairIndex], distance);
+
+		return hitsCount;
+	});
+}
+
+static void benchmarkBounds(Benchmark& benchmark, RandomEngine& random)
+{
+	benchmark.beginGroup("AABB");
+
+	std::vector<AABB> firstBounds;
+	std::vector<AABB> secondBounds;
+
+	std::vector<Ray> randomRays;
+	std::vector<Ray> hittingRays;
+
+	for (size_t pairIndex = 0; pairIndex < PAIRS_COUNT; pairIndex++) {
+		firstBounds.push_back(randomBounds(random, WORLD_SIZE * 0.05f));
+		secondBounds.push_back(randomBounds(random, WORLD_SIZE * 0.05f));
+
+		vector3 center = firstBounds.back().getCenter();
+
+		randomRays.push_back(randomRayTowards(random, center, WORLD_SIZE * 0.25f));
+		hittingRays.push_back(randomRayTowards(random, center, 0.0f));
+	}
+
+	benchmark.run("intersects(AABB), random", PAIRS_COUNT, [&]() {
+		size_t hitsCount = 0;
+
+		for (size_t pairIndex = 0; pairIndex < PAIRS_COUNT; pairIndex++)
+			hitsCount += firstBounds[pairIndex].intersects(secondBounds[pairIndex]);
+
+		return hitsCount;
+	});
+
+	benchmark.run("isRayIntersecting, random", PAIRS_COUNT, [&]() {
+		size_t hitsCount = 0;
+
+		for (size_t pairIndex = 0; pairIndex < PAIRS_COUNT; pairIndex++)
+			hitsCount += firstBounds[pairIndex].isRayIntersecting(randomRays[pairIndex]);
+
+		return hitsCount;
+	});
+
+	// All three slabs are clipped for the hitting rays
+	benchmark.run("isRayIntersecting, hitting", PAIRS_COUNT, [&]() {
+		size_t hitsCount = 0;
+
+		for (size_t pairIndex = 0; pairIndex < PAIRS_COUNT; pairIndex++)
+			hitsCount += firstBounds[pairIndex].isRayIntersecting(hittingRays[pairIndex]);
+
+		return hitsCount;
+	});
+
+	benchmark.run("intersects(Ray), random", PAIRS_COUNT, [&]() {
+		size_t hitsCount = 0;
+		float distance;
+
+		for (size_t pairIndex = 0; pairIndex < PAIRS_COUNT; pairIndex++)
+			hitsCount += firstBounds[pairIndex].intersects(randomRays[pairIndex], distance);
+
+		return hitsCount;
+	});
+}
+
+static void benchmarkSpheres(Benchmark& benchmark, RandomEngine& random)
+{
+	benchmark.beginGroup("Sphere");
+
+	std::vector<Sphere> spheres;
+
+	std::vector<Ray> randomRays;
+	std::vector<Ray> hittingRays;
+
+	for (size_t pairIndex = 0; pairIndex < PAIRS_COUNT; pairIndex++) {
+		spheres.push_back(Sphere(randomPosition(random, WORLD_SIZE * 0.05f),
+			randomFloat(random, MIN_COLLIDER_SIZE, MAX_COLLIDER_SIZE) * 0.5f));
+
+		vector3 center = spheres.back().getCenter();
+
+		randomRays.push_back(randomRayTowards(random, center, WORLD_SIZE * 0.25f));
+		hittingRays.push_back(randomRayTowards(random, center, 0.0f));
+	}
+
+	benchmark.run("isRayIntersecting, random", PAIRS_COUNT, [&]() {
+		size_t hitsCount = 0;
+
+		for (size_t pairIndex = 0; pairIndex < PAIRS_COUNT; pairIndex++)
+			hitsCount += spheres[pairIndex].isRayIntersecting(randomRays[pairIndex]);
+
+		return hitsCount;
+	});
+
+	benchmark.run("isRayIntersecting, hitting", PAIRS_COUNT, [&]() {
+		size_t hitsCount = 0;
+
+		for (size_t pairIndex = 0; pairIndex < PAIRS_COUNT; pairIndex++)
+			hitsCount += spheres[pairIndex].isRayIntersecting(hittingRays[pairIndex]);
+
+		return hitsCount;
+	});
+}
+
+static void benchmarkTriangles(Benchmark& benchmark, RandomEngine& random)
+{
+	benchmark.beginGroup("Triangle");
+
+	std::vector<Triangle> triangles;
+
+	std::vector<Ray> randomRays;
+	std::vector<Ray> hittingRays;
+
+	for (size_t pairIndex = 0; pairIndex < PAIRS_COUNT; pairIndex++) {
+		vector3 vertex = randomPosition(random, WORLD_SIZE * 0.05f);
+		vector3 firstEdge = randomDirection(random) * randomFloat(random, MIN_COLLIDER_SIZE, MAX_COLLIDER_SIZE);
+		vector3 secondEdge = randomDirection(random) * randomFloat(random, MIN_COLLIDER_SIZE, MAX_COLLIDER_SIZE);
+
+		triangles.push_back(Triangle(vertex, vertex + firstEdge, vertex + secondEdge));
+
+		// Centroid is inside of the triangle, so these rays pass all the barycentric checks
+		vector3 centroid = vertex + (firstEdge + secondEdge) / 3.0f;
+
+		randomRays.push_back(randomRayTowards(random, centroid, WORLD_SIZE * 0.25f));
+		hittingRays.push_back(randomRayTowards(random, centroid, 0.0f));
+	}
+
+	benchmark.run("isRayIntersecting, random", PAIRS_COUNT, [&]() {
+		size_t hitsCount = 0;
+
+		for (size_t pairIndex = 0; pairIndex < PAIRS_COUNT; pairIndex++)
+			hitsCount += triangles[pairIndex].isRayIntersecting(randomRays[pairIndex]);
+
+		return hitsCount;
+	});
+
+	benchmark.run("isRayIntersecting, hitting", PAIRS_COUNT, [&]() {
+		size_t hitsCount = 0;
+
+		for (size_t pairIndex = 0; pairIndex < PAIRS_COUNT; pairIndex++)
+			hitsCount += triangles[pairIndex].isRayIntersecting(hittingRays[pairIndex]);
+
+		return hitsCount;
+	});
+}
+
+static Capsule randomCapsule(RandomEngine& random, float extent)
+{
+	vector3 center = randomPosition(random, extent);
+	vector3 halfSegment = randomDirection(random) * randomFloat(random, MIN_COLLIDER_SIZE, MAX_COLLIDER_SIZE) * 0.5f;
+
+	return Capsule(center - halfSegment, center + halfSegment, randomFloat(random, MIN_COLLIDER_SIZE, MAX_COLLIDER_SIZE) * 0.25f);
+}
+
+template<class First, class Second, class FirstFactory, class SecondFactory>
+static void benchmarkPair(Benchmark& benchmark, RandomEngine& random, const std::string& name,
+	FirstFactory createFirst, SecondFactory createSecond)
+{
+	std::vector<First> firstColliders;
+	std::vector<Second> secondColliders;
+
+	for (size_t pairIndex = 0; pairIndex < PAIRS_COUNT; pairIndex++) {
+		firstColliders.push_back(createFirst(random, WORLD_SIZE * 0.05f));
+		secondColliders.push_back(createSecond(random, WORLD_SIZE * 0.05f));
+	}
+
+	benchmark.run(name + ", random", PAIRS_COUNT, [&]() {
+		size_t hitsCount = 0;
+		Intersection intersection;
+
+		for (size_t pairIndex = 0; pairIndex < PAIRS_COUNT; pairIndex++)
+			hitsCount += firstColliders[pairIndex].intersects(secondColliders[pairIndex], intersection);
+
+		return hitsCount;
+	});
+
+	// One collider against the whole level, pairs one by one and through the batch
+	std::vector<Second> levelColliders;
+	CollidersBatch<Second> batch;
+
+	for (size_t colliderIndex = 0; colliderIndex < PAIRS_COUNT; colliderIndex++) {
+		levelColliders.push_back(createSecond(random, WORLD_SIZE * 0.25f));
+		batch.add(levelColliders.back());
+	}
+
+	std::vector<BatchIntersection> intersections;
+
+	benchmark.run(name + ", one against N", PAIRS_COUNT * 16, [&]() {
+		size_t hitsCount = 0;
+		Intersection intersection;
+
+		for (size_t firstIndex = 0; firstIndex < 16; firstIndex++) {
+			for (const Second& collider : levelColliders)
+				hitsCount += firstColliders[firstIndex].intersects(collider, intersection);
+		}
+
+		return hitsCount;
+	});
+
+	benchmark.run(name + ", one against N batched", PAIRS_COUNT * 16, [&]() {
+		intersections.clear();
+
+		for (size_t firstIndex = 0; firstIndex < 16; firstIndex++)
+			batch.intersect(firstColliders[firstIndex], intersections);
+
+		return intersections.size();
+	});
+}
+
+static void benchmarkCollisionMatrix(Benchmark& benchmark, RandomEngine& random)
+{
+	benchmark.beginGroup("Matrix");
+
+	auto createBounds = [](RandomEngine& random, float extent) { return randomBounds(random, extent); };
+	auto createSphere = [](RandomEngine& random, float extent) {
+		return Sphere(randomPosition(random, extent), randomFloat(random, MIN_COLLIDER_SIZE, MAX_COLLIDER_SIZE) * 0.5f);
+	};
+	auto createBox = [](RandomEngine& random, float extent) { return randomBox(random, extent); };
+	auto createCapsule = [](RandomEngine& random, float extent) { return randomCapsule(random, extent); };
+
+	benchmarkPair<AABB, AABB>(benchmark, random, "AABB-AABB", createBounds, createBounds);
+	benchmarkPair<AABB, Sphere>(benchmark, random, "AABB-Sphere", createBounds, createSphere);
+	benchmarkPair<AABB, OBB>(benchmark, random, "AABB-OBB", createBounds, createBox);
+	benchmarkPair<AABB, Capsule>(benchmark, random, "AABB-Capsule", createBounds, createCapsule);
+	benchmarkPair<Sphere, Sphere>(benchmark, random, "Sphere-Sphere", createSphere, createSphere);
+	benchmarkPair<Sphere, OBB>(benchmark, random, "Sphere-OBB", createSphere, createBox);
+	benchmarkPair<Sphere, Capsule>(benchmark, random, "Sphere-Capsule", createSphere, createCapsule);
+	benchmarkPair<OBB, OBB>(benchmark, random, "OBB-OBB", createBox, createBox);
+	benchmarkPair<OBB, Capsule>(benchmark, random, "OBB-Capsule", createBox, createCapsule);
+	benchmarkPair<Capsule, Capsule>(benchmark, random, "Capsule-Capsule", createCapsule, createCapsule);
+}
+
+// Static hierarchy queries for the level of the given size and density
+static void benchmarkStaticHierarchy(Benchmark& benchmark, RandomEngine& random, size_t collidersCount, float extent)
+{
+	benchmark.beginGroup("BVH " + std::to_string(collidersCount) + " colliders, extent " +
+		std::to_string(static_cast<int>(extent)));
+
+	std::vector<AABB> collidersBounds;
+
+	for (size_t colliderIndex = 0; colliderIndex < collidersCount; colliderIndex++)
+		collidersBounds.push_back(randomBounds(random, extent));
+
+	BoundingVolumeHierarchy hierarchy(collidersBounds);
+
+	std::vector<AABB> queriesBounds;
+	std::vector<Ray> queriesRays;
+
+	for (size_t queryIndex = 0; queryIndex < PAIRS_COUNT; queryIndex++) {
+		queriesBounds.push_back(randomBounds(random, extent));
+		queriesRays.push_back(randomRayTowards(random, randomPosition(random, extent), 0.0f));
+	}
+
+	std::vector<size_t> items;
+
+	benchmark.run("query(AABB)", PAIRS_COUNT, [&]() {
+		size_t itemsCount = 0;
+
+		for (const AABB& bounds : queriesBounds) {
+			items.clear();
+			hierarchy.query(bounds, items);
+
+			itemsCount += items.size();
+		}
+
+		return itemsCount;
+	});
+
+	benchmark.run("query(Ray, 10m)", PAIRS_COUNT, [&]() {
+		size_t itemsCount = 0;
+
+		for (const Ray& ray : queriesRays) {
+			items.clear();
+			hierarchy.query(ray, 10.0f, items);
+
+			itemsCount += items.size();
+		}
+
+		return itemsCount;
+	});
+}
+
+// Rays starting on the grid lines lie in the planes of the triangles bounds, with zero direction components
+// across them. Every one of them should still hit the floor
+static bool checkTriangleMeshRaycasts(const TriangleMeshHierarchy& hierarchy, size_t gridSize)
+{
+	float cellSize = WORLD_SIZE / static_cast<float>(gridSize);
+
+	std::vector<Ray> rays;
+
+	for (size_t z = 0; z <= gridSize; z++) {
+		for (size_t x = 0; x <= gridSize; x++)
+			rays.push_back(Ray(vector3(x * cellSize - WORLD_SIZE * 0.5f, 1.0f, z * cellSize - WORLD_SIZE * 0.5f),
+				vector3(0.0f, -1.0f, 0.0f)));
+	}
+
+	std::vector<RaycastHit> hits(rays.size());
+	hierarchy.raycast(rays.data(), rays.size(), 3.0f, hits.data());
+
+	size_t missesCount = 0;
+
+	for (size_t rayIndex = 0; rayIndex < rays.size(); rayIndex++) {
+		RaycastHit singleHit;
+
+		if (!hits[rayIndex].isHit || !hierarchy.raycast(rays[rayIndex], 3.0f, singleHit))
+			missesCount++;
+	}
+
+	if (missesCount > 0)
+		printf("Triangle mesh: %zu of %zu rays on the grid lines missed the floor\n", missesCount, rays.size());
+
+	return missesCount == 0;
+}
+
+// Floor-like grid of triangles with slightly jittered heights
+static bool benchmarkTriangleMesh(Benchmark& benchmark, RandomEngine& random, size_t gridSize)
+{
+	benchmark.beginGroup("Triangle mesh " + std::to_string(gridSize * gridSize * 2) + " triangles");
+
+	std::vector<vector3> positions;
+	std::vector<uint32> indices;
+
+	float cellSize = WORLD_SIZE / static_cast<float>(gridSize);
+
+	for (size_t z = 0; z <= gridSize; z++) {
+		for (size_t x = 0; x <= gridSize; x++) {
+			positions.push_back(vector3(x * cellSize - WORLD_SIZE * 0.5f, randomFloat(random, -0.1f, 0.1f),
+				z * cellSize - WORLD_SIZE * 0.5f));
+		}
+	}
+
+	for (size_t z = 0; z < gridSize; z++) {
+		for (size_t x = 0; x < gridSize; x++) {
+			uint32 corner = static_cast<uint32>(z * (gridSize + 1) + x);
+			uint32 rowSize = static_cast<uint32>(gridSize + 1);
+
+			indices.insert(indices.end(), { corner, corner + rowSize, corner + 1 });
+			indices.insert(indices.end(), { corner + 1, corner + rowSize, corner + rowSize + 1 });
+		}
+	}
+
+	TriangleMeshHierarchy hierarchy(positions, indices);
+
+	bool isValid = checkTriangleMeshRaycasts(hierarchy, gridSize);
+
+	// Downward rays as the floor contacts use them
+	std::vector<Ray> rays;
+
+	for (size_t rayIndex = 0; rayIndex < PAIRS_COUNT; rayIndex++) {
+		vector3 origin = randomPosition(random, WORLD_SIZE * 0.5f);
+		origin.y = randomFloat(random, 0.5f, 2.0f);
+
+		rays.push_back(Ray(origin, vector3(0.0f, -1.0f, 0.0f)));
+	}
+
+	std::vector<RaycastHit> hits(rays.size());
+
+	benchmark.run("raycast, single rays", PAIRS_COUNT, [&]() {
+		size_t hitsCount = 0;
+
+		for (size_t rayIndex = 0; rayIndex < rays.size(); rayIndex++)
+			hitsCount += hierarchy.raycast(rays[rayIndex], 3.0f, hits[rayIndex]);
+
+		return hitsCount;
+	});
+
+	benchmark.run("raycast, batched rays", PAIRS_COUNT, [&]() {
+		hierarchy.raycast(rays.data(), rays.size(), 3.0f, hits.data());
+
+		size_t hitsCount = 0;
+
+		for (const RaycastHit& hit : hits)
+			hitsCount += hit.isHit;
+
+		return hitsCount;
+	});
+
+	return isValid;
+}
+
+// Moving bodies among the static colliders, the margin trades the tree updates for the false candidates
+static void benchmarkBroadphase(Benchmark& benchmark, RandomEngine& random, size_t bodiesCount, float margin)
+{
+	benchmark.beginGroup("Broadphase " + std::to_string(bodiesCount) + " bodies, margin " +
+		std::to_string(static_cast<int>(margin * 100.0f)) + "cm");
+
+	std::vector<AABB> staticBounds;
+
+	for (size_t colliderIndex = 0; colliderIndex < 4096; colliderIndex++)
+		staticBounds.push_back(randomBounds(random, WORLD_SIZE));
+
+	BoundingVolumeHierarchy staticHierarchy(staticBounds);
+
+	Broadphase broadphase(margin);
+	broadphase.setStaticHierarchy(&staticHierarchy);
+
+	std::vector<AABB> bodiesBounds;
+	std::vector<vector3> bodiesVelocities;
+	std::vector<Broadphase::ProxyId> bodiesProxies;
+
+	for (size_t bodyIndex = 0; bodyIndex < bodiesCount; bodyIndex++) {
+		bodiesBounds.push_back(randomBounds(random, WORLD_SIZE));
+		bodiesVelocities.push_back(randomDirection(random) * 0.05f);
+		bodiesProxies.push_back(broadphase.addDynamicCollider(bodiesBounds.back(), nullptr));
+	}
+
+	size_t stepIndex = 0;
+
+	benchmark.run("updateDynamicCollider", bodiesCount, [&]() {
+		// Bodies go back and forth, so they stay inside of the level
+		float direction = ((stepIndex++ / 64) % 2 == 0) ? 1.0f : -1.0f;
+
+		for (size_t bodyIndex = 0; bodyIndex < bodiesCount; bodyIndex++) {
+			vector3 displacement = bodiesVelocities[bodyIndex] * direction;
+
+			bodiesBounds[bodyIndex] = AABB(bodiesBounds[bodyIndex].getMin() + displacement,
+				bodiesBounds[bodyIndex].getMax() + displacement);
+			broadphase.updateDynamicCollider(bodiesProxies[bodyIndex], bodiesBounds[bodyIndex]);
+		}
+
+		return bodiesCount;
+	});
+
+	std::vector<size_t> staticColliders;
+	std::vector<Broadphase::ProxyId> dynamicProxies;
+
+	// Candidates of every body, the way the physics world gathers them before the narrowphase
+	benchmark.run("queryColliders", bodiesCount, [&]() {
+		size_t candidatesCount = 0;
+
+		for (size_t bodyIndex = 0; bodyIndex < bodiesCount; bodyIndex++) {
+			staticColliders.clear();
+			broadphase.queryStaticColliders(bodiesBounds[bodyIndex], staticColliders);
+
+			dynamicProxies.clear();
+			broadphase.queryDynamicColliders(bodiesBounds[bodyIndex], dynamicProxies);
+
+			candidatesCount += staticColliders.size() + dynamicProxies.size();
+		}
+
+		return candidatesCount;
+	});
+}
+
+int main(int argc, char* argv[])
+{
+	bool isQuick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+
+	Benchmark benchmark(isQuick ? QUICK_CASE_DURATION : CASE_DURATION);
+
+	// Fixed seed keeps the collider sets the same between runs
+	RandomEngine random(1234);
+
+	benchmarkBoxes(benchmark, random);
+	benchmarkBounds(benchmark, random);
+	benchmarkSpheres(benchmark, random);
+	benchmarkTriangles(benchmark, random);
+	benchmarkCollisionMatrix(benchmark, random);
+
+	benchmarkStaticHierarchy(benchmark, random, 1024, WORLD_SIZE);
+	benchmarkStaticHierarchy(benchmark, random, 16384, WORLD_SIZE);
+	benchmarkStaticHierarchy(benchmark, random, 16384, WORLD_SIZE * 4.0f);
+
+	bool isValid = true;
+
+	isValid &= benchmarkTriangleMesh(benchmark, random, 32);
+	isValid &= benchmarkTriangleMesh(benchmark, random, 256);
+
+	benchmarkBroadphase(benchmark, random, 256, 0.0f);
+	benchmarkBroadphase(benchmark, random, 256, 0.1f);
+	benchmarkBroadphase(benchmark, random, 256, 0.5f);
+	benchmarkBroadphase(benchmark, random, 2048, 0.1f);
+
+	benchmark.printResults();
+
+	return isValid ? 0 : 1;
+}
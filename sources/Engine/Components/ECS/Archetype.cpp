@@ -0,0 +1,167 @@
+#include "Archetype.h"
+
+#include <Engine\assertions.h>
+
+#include <algorithm>
+
+static size_t alignOffset(size_t offset, size_t alignment)
+{
+	return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+Archetype::Archetype(ComponentsMask mask)
+	: m_mask(mask),
+	m_chunkCapacity(0),
+	m_size(0)
+{
+	size_t rowSize = sizeof(Entity);
+
+	for (ComponentTypeId typeId = 0; typeId < ComponentTypes::MAX_COMPONENT_TYPES_COUNT; typeId++) {
+		if ((mask & (ComponentsMask(1) << typeId)) == 0)
+			continue;
+
+		const ComponentTypeInfo& info = ComponentTypes::getInfo(typeId);
+
+		// Chunks are aligned for any fundamental type only
+		_assert(info.alignment <= alignof(std::max_align_t));
+
+		m_componentTypes.push_back(typeId);
+		rowSize += info.size;
+	}
+
+	m_componentsOffsets.resize(m_componentTypes.size());
+
+	// Every array may need padding for the alignment, so the capacity is decreased until the arrays fit
+	m_chunkCapacity = CHUNK_BYTES_COUNT / rowSize;
+
+	while (true) {
+		size_t offset = sizeof(Entity) * m_chunkCapacity;
+
+		for (size_t typeIndex = 0; typeIndex < m_componentTypes.size(); typeIndex++) {
+			const ComponentTypeInfo& info = ComponentTypes::getInfo(m_componentTypes[typeIndex]);
+
+			offset = alignOffset(offset, info.alignment);
+			m_componentsOffsets[typeIndex] = offset;
+			offset += info.size * m_chunkCapacity;
+		}
+
+		if (offset <= CHUNK_BYTES_COUNT)
+			break;
+
+		m_chunkCapacity--;
+	}
+
+	// The component is larger than a chunk
+	_assert(m_chunkCapacity > 0);
+}
+
+Archetype::~Archetype()
+{
+	for (size_t row = 0; row < m_size; row++) {
+		for (ComponentTypeId typeId : m_componentTypes)
+			ComponentTypes::getInfo(typeId).destroy(getComponent(row, typeId));
+	}
+
+	for (std::byte* chunk : m_chunks)
+		::operator delete(chunk);
+}
+
+ComponentsMask Archetype::getMask() const
+{
+	return m_mask;
+}
+
+bool Archetype::hasComponent(ComponentTypeId typeId) const
+{
+	return (m_mask & (ComponentsMask(1) << typeId)) != 0;
+}
+
+size_t Archetype::allocateRow(Entity entity)
+{
+	if (m_size == m_chunks.size() * m_chunkCapacity)
+		m_chunks.push_back(static_cast<std::byte*>(::operator new(CHUNK_BYTES_COUNT)));
+
+	size_t row = m_size;
+	m_size++;
+
+	getChunkEntities(row / m_chunkCapacity)[row % m_chunkCapacity] = entity;
+
+	return row;
+}
+
+Entity Archetype::removeRow(size_t row, bool destroyComponents)
+{
+	_assert(row < m_size);
+
+	size_t lastRow = m_size - 1;
+
+	for (ComponentTypeId typeId : m_componentTypes) {
+		const ComponentTypeInfo& info = ComponentTypes::getInfo(typeId);
+		void* component = getComponent(row, typeId);
+
+		if (destroyComponents)
+			info.destroy(component);
+
+		if (row != lastRow) {
+			void* lastComponent = getComponent(lastRow, typeId);
+
+			info.moveConstruct(component, lastComponent);
+			info.destroy(lastComponent);
+		}
+	}
+
+	Entity* rowEntity = getChunkEntities(row / m_chunkCapacity) + row % m_chunkCapacity;
+	*rowEntity = getChunkEntities(lastRow / m_chunkCapacity)[lastRow % m_chunkCapacity];
+
+	m_size--;
+
+	// One empty chunk is kept, so an entity moving back and forth doesn't reallocate it
+	if (m_chunks.size() > 1 && m_size + 2 * m_chunkCapacity <= m_chunks.size() * m_chunkCapacity) {
+		::operator delete(m_chunks.back());
+		m_chunks.pop_back();
+	}
+
+	return *rowEntity;
+}
+
+void * Archetype::getComponent(size_t row, ComponentTypeId typeId) const
+{
+	_assert(row < m_size);
+
+	return static_cast<std::byte*>(getChunkComponents(row / m_chunkCapacity, typeId)) +
+		ComponentTypes::getInfo(typeId).size * (row % m_chunkCapacity);
+}
+
+size_t Archetype::getSize() const
+{
+	return m_size;
+}
+
+size_t Archetype::getChunksCount() const
+{
+	return (m_size + m_chunkCapacity - 1) / m_chunkCapacity;
+}
+
+size_t Archetype::getChunkSize(size_t chunkIndex) const
+{
+	return std::min(m_chunkCapacity, m_size - chunkIndex * m_chunkCapacity);
+}
+
+Entity * Archetype::getChunkEntities(size_t chunkIndex) const
+{
+	return reinterpret_cast<Entity*>(m_chunks[chunkIndex]);
+}
+
+void * Archetype::getChunkComponents(size_t chunkIndex, ComponentTypeId typeId) const
+{
+	return m_chunks[chunkIndex] + getComponentOffset(typeId);
+}
+
+size_t Archetype::getComponentOffset(ComponentTypeId typeId) const
+{
+	auto typeIt = std::lower_bound(m_componentTypes.begin(), m_componentTypes.end(), typeId);
+
+	_assert(typeIt != m_componentTypes.end() && *typeIt == typeId);
+
+	return m_componentsOffsets[typeIt - m_componentTypes.begin()];
+}
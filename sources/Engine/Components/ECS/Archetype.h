@@ -0,0 +1,62 @@
+#pragma once
+
+#include "ComponentTypes.h"
+
+#include <Engine\Components\Memory\SlotMap.h>
+
+#include <vector>
+#include <cstddef>
+
+using Entity = SlotMapHandle;
+
+// Entities having the same set of components. They are kept in fixed-size chunks, a chunk holds
+// an array of the entities and an array per component type, so a system reads only the components it needs.
+// Rows are kept dense: the removed row is replaced by the last one
+class Archetype {
+public:
+	Archetype(ComponentsMask mask);
+	~Archetype();
+
+	ComponentsMask getMask() const;
+	bool hasComponent(ComponentTypeId typeId) const;
+
+	// The components of the new row aren't constructed
+	size_t allocateRow(Entity entity);
+
+	// Moves the last row into the removed one and returns the moved entity.
+	// Components of the removed row are destroyed unless they were moved out before
+	Entity removeRow(size_t row, bool destroyComponents);
+
+	void* getComponent(size_t row, ComponentTypeId typeId) const;
+
+	size_t getSize() const;
+
+	size_t getChunksCount() const;
+	size_t getChunkSize(size_t chunkIndex) const;
+
+	Entity* getChunkEntities(size_t chunkIndex) const;
+	void* getChunkComponents(size_t chunkIndex, ComponentTypeId typeId) const;
+
+private:
+	Archetype(const Archetype& archetype) = delete;
+	Archetype& operator=(const Archetype& archetype) = delete;
+
+private:
+	size_t getComponentOffset(ComponentTypeId typeId) const;
+
+private:
+	static const size_t CHUNK_BYTES_COUNT = 16 * 1024;
+
+private:
+	ComponentsMask m_mask;
+
+	std::vector<ComponentTypeId> m_componentTypes;
+
+	// Offsets of the component arrays in a chunk, in the order of the types
+	std::vector<size_t> m_componentsOffsets;
+
+	size_t m_chunkCapacity;
+	std::vector<std::byte*> m_chunks;
+
+	size_t m_size;
+};
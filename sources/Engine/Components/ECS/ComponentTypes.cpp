@@ -0,0 +1,29 @@
+#include "ComponentTypes.h"
+
+#include <Engine\assertions.h>
+
+#include <mutex>
+
+ComponentTypeInfo ComponentTypes::s_infos[MAX_COMPONENT_TYPES_COUNT];
+size_t ComponentTypes::s_typesCount = 0;
+
+static std::mutex s_registrationMutex;
+
+const ComponentTypeInfo & ComponentTypes::getInfo(ComponentTypeId id)
+{
+	_assert(id < MAX_COMPONENT_TYPES_COUNT);
+
+	return s_infos[id];
+}
+
+ComponentTypeId ComponentTypes::registerType(const ComponentTypeInfo & info)
+{
+	std::lock_guard<std::mutex> lock(s_registrationMutex);
+
+	// The mask has no bit for more types
+	_assert(s_typesCount < MAX_COMPONENT_TYPES_COUNT);
+
+	s_infos[s_typesCount] = info;
+
+	return s_typesCount++;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <Engine\types.h>
+
+#include <new>
+#include <utility>
+
+using ComponentTypeId = size_t;
+
+// Set of the component types, a bit per type
+using ComponentsMask = uint64;
+
+// Operations on the components of a type, so the archetypes can keep them as raw memory
+struct ComponentTypeInfo {
+	size_t size;
+	size_t alignment;
+
+	void(*moveConstruct)(void* destination, void* source);
+	void(*destroy)(void* component);
+};
+
+// Gives every component type a small id on its first use
+class ComponentTypes {
+public:
+	template<class T>
+	static ComponentTypeId getId();
+
+	template<class... Components>
+	static ComponentsMask getMask();
+
+	static const ComponentTypeInfo& getInfo(ComponentTypeId id);
+
+public:
+	static const size_t MAX_COMPONENT_TYPES_COUNT = sizeof(ComponentsMask) * 8;
+
+private:
+	static ComponentTypeId registerType(const ComponentTypeInfo& info);
+
+private:
+	// Infos are never moved, so they are read without a lock
+	static ComponentTypeInfo s_infos[MAX_COMPONENT_TYPES_COUNT];
+	static size_t s_typesCount;
+};
+
+template<class T>
+inline ComponentTypeId ComponentTypes::getId()
+{
+	static const ComponentTypeId id = registerType({
+		sizeof(T),
+		alignof(T),
+		[](void* destination, void* source) { new (destination) T(std::move(*static_cast<T*>(source))); },
+		[](void* component) { static_cast<T*>(component)->~T(); }
+	});
+
+	return id;
+}
+
+template<class... Components>
+inline ComponentsMask ComponentTypes::getMask()
+{
+	return (ComponentsMask(0) | ... | (ComponentsMask(1) << getId<Components>()));
+}
@@ -0,0 +1,102 @@
+#include "EntityManager.h"
+
+#include <Engine\assertions.h>
+
+EntityManager::EntityManager()
+{
+}
+
+EntityManager::~EntityManager()
+{
+	for (Archetype* archetype : m_archetypes)
+		delete archetype;
+}
+
+void EntityManager::destroyEntity(Entity entity)
+{
+	EntityLocation* location = m_entities.get(entity);
+
+	_assert(location != nullptr);
+
+	removeRow(location->archetype, location->row, true);
+	m_entities.remove(entity);
+}
+
+bool EntityManager::isAlive(Entity entity) const
+{
+	return m_entities.contains(entity);
+}
+
+size_t EntityManager::getEntitiesCount() const
+{
+	return m_entities.getSize();
+}
+
+size_t EntityManager::getArchetypesCount() const
+{
+	return m_archetypes.size();
+}
+
+Archetype * EntityManager::getArchetype(ComponentsMask mask)
+{
+	auto archetypeIt = m_archetypesByMask.find(mask);
+
+	if (archetypeIt != m_archetypesByMask.end())
+		return archetypeIt->second;
+
+	Archetype* archetype = new Archetype(mask);
+
+	m_archetypesByMask.insert({ mask, archetype });
+	m_archetypes.push_back(archetype);
+
+	return archetype;
+}
+
+void EntityManager::moveEntity(Entity entity, ComponentsMask newMask)
+{
+	EntityLocation* location = m_entities.get(entity);
+
+	Archetype* oldArchetype = location->archetype;
+	size_t oldRow = location->row;
+
+	Archetype* newArchetype = getArchetype(newMask);
+	size_t newRow = newArchetype->allocateRow(entity);
+
+	// The components missing in the new archetype are destroyed by the caller
+	ComponentsMask commonMask = oldArchetype->getMask() & newMask;
+
+	for (ComponentTypeId typeId = 0; typeId < ComponentTypes::MAX_COMPONENT_TYPES_COUNT; typeId++) {
+		if ((commonMask & (ComponentsMask(1) << typeId)) == 0)
+			continue;
+
+		const ComponentTypeInfo& info = ComponentTypes::getInfo(typeId);
+		void* oldComponent = oldArchetype->getComponent(oldRow, typeId);
+
+		info.moveConstruct(newArchetype->getComponent(newRow, typeId), oldComponent);
+		info.destroy(oldComponent);
+	}
+
+	removeRow(oldArchetype, oldRow, false);
+
+	location = m_entities.get(entity);
+	location->archetype = newArchetype;
+	location->row = newRow;
+}
+
+void EntityManager::removeRow(Archetype * archetype, size_t row, bool destroyComponents)
+{
+	Entity movedEntity = archetype->removeRow(row, destroyComponents);
+
+	// The last entity of the archetype took the row
+	if (row < archetype->getSize())
+		m_entities.get(movedEntity)->row = row;
+}
+
+void * EntityManager::getComponent(Entity entity, ComponentTypeId typeId) const
+{
+	const EntityLocation* location = m_entities.get(entity);
+
+	_assert(location != nullptr);
+
+	return location->archetype->getComponent(location->row, typeId);
+}
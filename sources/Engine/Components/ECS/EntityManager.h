@@ -0,0 +1,168 @@
+#pragma once
+
+#include "Archetype.h"
+
+#include <unordered_map>
+#include <type_traits>
+#include <utility>
+
+// Entities are handles, their components are kept by the archetypes. Adding or removing a component
+// moves the entity to the archetype of the new components set.
+// forEach visits the entities having the required components, chunk by chunk.
+// Entities and components shouldn't be added or removed while it iterates
+class EntityManager {
+public:
+	EntityManager();
+	~EntityManager();
+
+	template<class... Components>
+	Entity createEntity(Components&&... components);
+	void destroyEntity(Entity entity);
+
+	bool isAlive(Entity entity) const;
+
+	template<class T>
+	void addComponent(Entity entity, T&& component);
+
+	template<class T>
+	void removeComponent(Entity entity);
+
+	template<class T>
+	bool hasComponent(Entity entity) const;
+
+	// Returns null if the entity has no such component
+	template<class T>
+	T* getComponent(Entity entity) const;
+
+	// Calls the function(Entity, Components&...) for every entity having the components
+	template<class... Components, class Function>
+	void forEach(const Function& function);
+
+	size_t getEntitiesCount() const;
+	size_t getArchetypesCount() const;
+
+private:
+	struct EntityLocation {
+		Archetype* archetype;
+		size_t row;
+	};
+
+private:
+	EntityManager(const EntityManager& manager) = delete;
+	EntityManager& operator=(const EntityManager& manager) = delete;
+
+	Archetype* getArchetype(ComponentsMask mask);
+
+	// The components of the new archetype missing in the old one aren't constructed
+	void moveEntity(Entity entity, ComponentsMask newMask);
+	void removeRow(Archetype* archetype, size_t row, bool destroyComponents);
+
+	void* getComponent(Entity entity, ComponentTypeId typeId) const;
+
+	// Calls the function(Entity*, size_t, Components*...) for every chunk of the matching archetypes
+	template<class... Components, class Function>
+	void forEachChunk(const Function& function);
+
+	template<class... Components, class Function>
+	void processChunk(Archetype* archetype, size_t chunkIndex, const Function& function);
+
+private:
+	SlotMap<EntityLocation> m_entities;
+
+	std::unordered_map<ComponentsMask, Archetype*> m_archetypesByMask;
+	std::vector<Archetype*> m_archetypes;
+};
+
+template<class... Components>
+inline Entity EntityManager::createEntity(Components&&... components)
+{
+	ComponentsMask mask = ComponentTypes::getMask<std::decay_t<Components>...>();
+	Archetype* archetype = getArchetype(mask);
+
+	Entity entity = m_entities.insert({ archetype, 0 });
+	size_t row = archetype->allocateRow(entity);
+
+	m_entities.get(entity)->row = row;
+
+	(new (archetype->getComponent(row, ComponentTypes::getId<std::decay_t<Components>>()))
+		std::decay_t<Components>(std::forward<Components>(components)), ...);
+
+	return entity;
+}
+
+template<class T>
+inline void EntityManager::addComponent(Entity entity, T&& component)
+{
+	using ComponentType = std::decay_t<T>;
+
+	_assert(!hasComponent<ComponentType>(entity));
+
+	ComponentTypeId typeId = ComponentTypes::getId<ComponentType>();
+	const EntityLocation* location = m_entities.get(entity);
+
+	moveEntity(entity, location->archetype->getMask() | (ComponentsMask(1) << typeId));
+
+	new (getComponent(entity, typeId)) ComponentType(std::forward<T>(component));
+}
+
+template<class T>
+inline void EntityManager::removeComponent(Entity entity)
+{
+	_assert(hasComponent<T>(entity));
+
+	ComponentTypeId typeId = ComponentTypes::getId<T>();
+	const EntityLocation* location = m_entities.get(entity);
+
+	ComponentTypes::getInfo(typeId).destroy(getComponent(entity, typeId));
+
+	moveEntity(entity, location->archetype->getMask() & ~(ComponentsMask(1) << typeId));
+}
+
+template<class T>
+inline bool EntityManager::hasComponent(Entity entity) const
+{
+	const EntityLocation* location = m_entities.get(entity);
+
+	_assert(location != nullptr);
+
+	return location->archetype->hasComponent(ComponentTypes::getId<T>());
+}
+
+template<class T>
+inline T * EntityManager::getComponent(Entity entity) const
+{
+	if (!hasComponent<T>(entity))
+		return nullptr;
+
+	return static_cast<T*>(getComponent(entity, ComponentTypes::getId<T>()));
+}
+
+template<class... Components, class Function>
+inline void EntityManager::forEach(const Function & function)
+{
+	forEachChunk<Components...>([&function](Entity* entities, size_t count, Components*... components) {
+		for (size_t index = 0; index < count; index++)
+			function(entities[index], components[index]...);
+	});
+}
+
+template<class... Components, class Function>
+inline void EntityManager::forEachChunk(const Function & function)
+{
+	ComponentsMask mask = ComponentTypes::getMask<Components...>();
+
+	for (Archetype* archetype : m_archetypes) {
+		if ((archetype->getMask() & mask) != mask)
+			continue;
+
+		for (size_t chunkIndex = 0; chunkIndex < archetype->getChunksCount(); chunkIndex++)
+			processChunk<Components...>(archetype, chunkIndex, function);
+	}
+}
+
+template<class... Components, class Function>
+inline void EntityManager::processChunk(Archetype * archetype, size_t chunkIndex, const Function & function)
+{
+	function(archetype->getChunkEntities(chunkIndex), archetype->getChunkSize(chunkIndex),
+		static_cast<Components*>(archetype->getChunkComponents(chunkIndex, ComponentTypes::getId<Components>()))...);
+}
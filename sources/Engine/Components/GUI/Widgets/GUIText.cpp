@@ -3,6 +3,7 @@
 #include <algorithm>
 
 #include <Engine\assertions.h>
+#include <Engine\Components\Memory\FrameAllocator.h>
 
 GUIText::GUIText(GraphicsResourceFactory * graphicsResourceFactory)
 	: m_graphicsResourceFactory(graphicsResourceFactory), 
@@ -139,8 +140,9 @@ void GUIText::update(const MousePosition & mousePosition)
  
 void GUIText::updateTextGeometry()
 {
-	std::vector<vector4> vertices;
-	std::vector<unsigned int> indices;
+	// Geometry is copied to the buffers at once, so the arrays are temporary
+	FrameVector<vector4> vertices;
+	FrameVector<unsigned int> indices;
 
 	unsigned int bitmapWidth = m_font->getBitmap()->getWidth();
 	unsigned int bitmapHeight = m_font->getBitmap()->getHeight();
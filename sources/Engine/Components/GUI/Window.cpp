@@ -87,6 +87,10 @@ void Window::getCursorPosition(real64* x, real64* y) const {
 	glfwGetCursorPos(m_windowPointer, x, y);
 }
 
+void Window::setVSyncEnabled(bool enabled) {
+	glfwSwapInterval(enabled ? 1 : 0);
+}
+
 void Window::close() {
 	glfwSetWindowShouldClose(this->m_windowPointer, GL_TRUE);
 }
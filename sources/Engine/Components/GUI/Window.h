@@ -34,6 +34,9 @@ public:
 	WindowCursorState getCursorPosition() const;
 	void getCursorPosition(real64*, real64*) const;
 
+	// Synchronizes the buffers swapping with the display refresh rate
+	void setVSyncEnabled(bool enabled);
+
 	void close();
 	bool shouldClose() const;
 
@@ -144,4 +144,21 @@ void OpenGL3GeometryStore::drawElements(DrawType drawType, size_t offset, size_t
 	}
 
 	OPENGL3_CALL(glDrawElements(drawMode, count, glIndicesType, (const void*)(offset * offsetMultiplier)));
+}
+
+void OpenGL3GeometryStore::drawElementsInstanced(DrawType drawType, size_t offset, size_t count, IndicesType indicesType, size_t instancesCount) {
+	GLenum drawMode;
+
+	if (drawType == DrawType::Triangles)
+		drawMode = GL_TRIANGLES;
+
+	GLenum glIndicesType;
+	size_t offsetMultiplier;
+
+	if (indicesType == IndicesType::UnsignedInt) {
+		glIndicesType = GL_UNSIGNED_INT;
+		offsetMultiplier = sizeof(unsigned int);
+	}
+
+	OPENGL3_CALL(glDrawElementsInstanced(drawMode, count, glIndicesType, (const void*)(offset * offsetMultiplier), instancesCount));
 }
\ No newline at end of file
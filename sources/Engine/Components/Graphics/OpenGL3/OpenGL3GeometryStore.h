@@ -35,6 +35,7 @@ public:
 
 	virtual void drawArrays(DrawType drawType, size_t offset, size_t count);
 	virtual void drawElements(DrawType drawType, size_t offset, size_t count, IndicesType indicesType);
+	virtual void drawElementsInstanced(DrawType drawType, size_t offset, size_t count, IndicesType indicesType, size_t instancesCount);
 protected:
 	GLuint m_VAO;
 
@@ -132,6 +132,18 @@ void OpenGL3GpuProgram::setParameter(const std::string& parameterName, const mat
 	OPENGL3_CALL(glUniformMatrix4fv(getUniformLocation(parameterName), 1, GL_FALSE, &parameterValue[0][0]));
 }
 
+void OpenGL3GpuProgram::setParameter(const std::string& parameterName, const float* parameterValues, size_t count) {
+	OPENGL3_CALL(glUniform1fv(getUniformLocation(parameterName), count, parameterValues));
+}
+
+void OpenGL3GpuProgram::setParameter(const std::string& parameterName, const vector4* parameterValues, size_t count) {
+	OPENGL3_CALL(glUniform4fv(getUniformLocation(parameterName), count, &parameterValues[0][0]));
+}
+
+void OpenGL3GpuProgram::setParameter(const std::string& parameterName, const matrix4* parameterValues, size_t count) {
+	OPENGL3_CALL(glUniformMatrix4fv(getUniformLocation(parameterName), count, GL_FALSE, &parameterValues[0][0][0]));
+}
+
 GLint OpenGL3GpuProgram::getUniformLocation(const std::string & name) const
 {
 	GLint location = glGetUniformLocation(m_program, name.c_str());
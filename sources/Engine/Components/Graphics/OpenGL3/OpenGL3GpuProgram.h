@@ -29,6 +29,10 @@ public:
 	void setParameter(const std::string& name, const vector4& value) override;
 	void setParameter(const std::string& name, const matrix4& value) override;
 
+	void setParameter(const std::string& name, const float* values, size_t count) override;
+	void setParameter(const std::string& name, const vector4* values, size_t count) override;
+	void setParameter(const std::string& name, const matrix4* values, size_t count) override;
+
 private:
 	GLint getUniformLocation(const std::string& name) const;
 
@@ -41,4 +41,5 @@ public:
 
 	virtual void drawArrays(DrawType drawType, size_t offset, size_t count) = 0;
 	virtual void drawElements(DrawType drawType, size_t offset, size_t count, IndicesType indicesType) = 0;
+	virtual void drawElementsInstanced(DrawType drawType, size_t offset, size_t count, IndicesType indicesType, size_t instancesCount) = 0;
 };
\ No newline at end of file
@@ -33,4 +33,9 @@ public:
 	virtual void setParameter(const std::string& name, const vector3& value) = 0;
 	virtual void setParameter(const std::string& name, const vector4& value) = 0;
 	virtual void setParameter(const std::string& name, const matrix4& value) = 0;
+
+	// Uploads the whole array with one call, name should point to the first element
+	virtual void setParameter(const std::string& name, const float* values, size_t count) = 0;
+	virtual void setParameter(const std::string& name, const vector4* values, size_t count) = 0;
+	virtual void setParameter(const std::string& name, const matrix4* values, size_t count) = 0;
 };
\ No newline at end of file
@@ -2,13 +2,25 @@
 
 #include <Engine\assertions.h>
 
-InputManager::InputManager(Window* window) : m_window(window) {
+#include <algorithm>
+#include <iterator>
+
+InputManager::InputManager(Window* window) 
+	: m_window(window),
+	m_mousePosition({ 0.0, 0.0 })
+{
+	// Codes below the space aren't keys
+	std::fill(std::begin(m_keysStates), std::end(m_keysStates), GLFW_RELEASE);
+	std::fill(std::begin(m_mouseButtonsStates), std::end(m_mouseButtonsStates), GLFW_RELEASE);
+
 	glfwSetWindowUserPointer(m_window->getWindowPointer(), this);
 	glfwSetKeyCallback(m_window->getWindowPointer(), keyCallback);
 	glfwSetCharCallback(m_window->getWindowPointer(), charCallback);
 	glfwSetCursorPosCallback(m_window->getWindowPointer(), mouseMovedCallback);
 	glfwSetMouseButtonCallback(m_window->getWindowPointer(), mouseButtonCallback);
 	glfwSetScrollCallback(m_window->getWindowPointer(), scrollCallback);
+
+	update();
 }
 
 InputManager::~InputManager() {
@@ -16,7 +28,15 @@ InputManager::~InputManager() {
 }
 
 void InputManager::update() {
+	GLFWwindow* window = m_window->getWindowPointer();
 
+	for (int key = GLFW_KEY_SPACE; key <= GLFW_KEY_LAST; key++)
+		m_keysStates[key] = glfwGetKey(window, key);
+
+	for (int button = 0; button <= GLFW_MOUSE_BUTTON_LAST; button++)
+		m_mouseButtonsStates[button] = glfwGetMouseButton(window, button);
+
+	glfwGetCursorPos(window, &m_mousePosition.x, &m_mousePosition.y);
 }
 
 void InputManager::registerEventListener(InputEventsListener* listener) {
@@ -36,7 +56,7 @@ void InputManager::unregisterEventListener(InputEventsListener* listener) {
 KeyState InputManager::getKeyState(Key key) const {
 	KeyState state = KeyState::Unknown;
 
-	switch (glfwGetKey(m_window->getWindowPointer(), key)) {
+	switch (getSampledKeyState(key)) {
 	case GLFW_PRESS:
 		state = KeyState::Pressed;
 		break;
@@ -54,28 +74,25 @@ KeyState InputManager::getKeyState(Key key) const {
 }
 
 bool InputManager::isKeyPressed(Key key) const {
-	return glfwGetKey(m_window->getWindowPointer(), key) == GLFW_PRESS;
+	return getSampledKeyState(key) == GLFW_PRESS;
 }
 
 bool InputManager::isKeyReleased(Key key) const {
-	return glfwGetKey(m_window->getWindowPointer(), key) == GLFW_RELEASE;
+	return getSampledKeyState(key) == GLFW_RELEASE;
 }
 
 bool InputManager::isKeyRepeated(Key key) const {
-	return glfwGetKey(m_window->getWindowPointer(), key) == GLFW_REPEAT;
+	return getSampledKeyState(key) == GLFW_REPEAT;
 }
 
 MousePosition InputManager::getMousePosition() const {
-	MousePosition pos;
-	glfwGetCursorPos(m_window->getWindowPointer(), &pos.x, &pos.y);
-	
-	return pos;
+	return m_mousePosition;
 }
 
 MouseButtonState InputManager::getMouseButtonState(MouseButton button) const {
 	MouseButtonState state = MouseButtonState::Unknown;
 
-	switch (glfwGetMouseButton(m_window->getWindowPointer(), button)) {
+	switch (getSampledMouseButtonState(button)) {
 	case GLFW_PRESS:
 		state = MouseButtonState::Pressed;
 		break;
@@ -152,6 +169,10 @@ void InputManager::onCharacterEnteredEvent(unsigned int character)
 }
 
 void InputManager::onMouseMovedEvent(double x, double y) {
+	// Events are handled on the main thread between the updates
+	m_mousePosition.x = x;
+	m_mousePosition.y = y;
+
 	MouseState state;
 	state.position.x = x;
 	state.position.y = y;
@@ -207,6 +228,20 @@ void InputManager::onScrollEvent(double offsetX, double offsetY) {
 	}
 }
 
+int InputManager::getSampledKeyState(Key key) const {
+	if (key > GLFW_KEY_LAST)
+		return GLFW_RELEASE;
+
+	return m_keysStates[key];
+}
+
+int InputManager::getSampledMouseButtonState(MouseButton button) const {
+	if (button > GLFW_MOUSE_BUTTON_LAST)
+		return GLFW_RELEASE;
+
+	return m_mouseButtonsStates[button];
+}
+
 void InputManager::keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
 	auto inputManager = reinterpret_cast<InputManager*>(glfwGetWindowUserPointer(window));
 	inputManager->onKeyEvent(key, scancode, action, mods);
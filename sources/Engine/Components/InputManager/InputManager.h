@@ -14,6 +14,8 @@ public:
 	InputManager(Window* window);
 	~InputManager();
 
+	// Samples the keys, the mouse buttons and the cursor position, the getters return the sampled states,
+	// so the updates running on a worker thread don't call the window system
 	void update();
 
 	void registerEventListener(InputEventsListener* listener);
@@ -34,6 +36,9 @@ private:
 	void onMouseButtonEvent(int button, int action, int mods);
 	void onScrollEvent(double offsetX, double offsetY);
 
+	int getSampledKeyState(Key key) const;
+	int getSampledMouseButtonState(MouseButton button) const;
+
 	static void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
 	static void charCallback(GLFWwindow* window, unsigned int codepoint);
 	static void mouseMovedCallback(GLFWwindow* window, double x, double y);
@@ -42,5 +47,9 @@ private:
 private:
 	Window* m_window;
 
+	int m_keysStates[GLFW_KEY_LAST + 1];
+	int m_mouseButtonsStates[GLFW_MOUSE_BUTTON_LAST + 1];
+	MousePosition m_mousePosition;
+
 	std::vector<InputEventsListener*> m_eventListeners;
 };
\ No newline at end of file
@@ -0,0 +1,39 @@
+#include "DualQuaternion.h"
+
+DualQuaternion::DualQuaternion()
+	: m_real(1.0f, 0.0f, 0.0f, 0.0f), m_dual(0.0f, 0.0f, 0.0f, 0.0f)
+{
+}
+
+DualQuaternion::DualQuaternion(const quaternion & orientation, const vector3 & translation)
+	: m_real(glm::normalize(orientation))
+{
+	m_dual = quaternion(0.0f, translation.x, translation.y, translation.z) * m_real * 0.5f;
+}
+
+DualQuaternion DualQuaternion::fromMatrix(const matrix4 & transform)
+{
+	return DualQuaternion(glm::quat_cast(matrix3(transform)), vector3(transform[3]));
+}
+
+const quaternion & DualQuaternion::getReal() const
+{
+	return m_real;
+}
+
+const quaternion & DualQuaternion::getDual() const
+{
+	return m_dual;
+}
+
+quaternion DualQuaternion::getOrientation() const
+{
+	return m_real;
+}
+
+vector3 DualQuaternion::getTranslation() const
+{
+	quaternion translation = m_dual * glm::conjugate(m_real) * 2.0f;
+
+	return vector3(translation.x, translation.y, translation.z);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "types.h"
+
+// Rigid transform (rotation + translation) as a unit dual quaternion
+class DualQuaternion
+{
+public:
+	DualQuaternion();
+	DualQuaternion(const quaternion& orientation, const vector3& translation);
+
+	// The matrix must not contain scale or shear
+	static DualQuaternion fromMatrix(const matrix4& transform);
+
+	const quaternion& getReal() const;
+	const quaternion& getDual() const;
+
+	quaternion getOrientation() const;
+	vector3 getTranslation() const;
+
+private:
+	quaternion m_real;
+	quaternion m_dual;
+};
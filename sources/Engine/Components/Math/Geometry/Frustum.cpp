@@ -0,0 +1,49 @@
+#include "Frustum.h"
+
+Frustum::Frustum()
+	: Frustum(matrix4(1.0f))
+{
+}
+
+Frustum::Frustum(const matrix4 & viewProjectionTransform)
+{
+	setViewProjectionTransform(viewProjectionTransform);
+}
+
+Frustum::~Frustum()
+{
+}
+
+void Frustum::setViewProjectionTransform(const matrix4 & viewProjectionTransform)
+{
+	// Gribb-Hartmann planes extraction, glm matrices are column-major
+	vector4 row0(viewProjectionTransform[0][0], viewProjectionTransform[1][0], viewProjectionTransform[2][0], viewProjectionTransform[3][0]);
+	vector4 row1(viewProjectionTransform[0][1], viewProjectionTransform[1][1], viewProjectionTransform[2][1], viewProjectionTransform[3][1]);
+	vector4 row2(viewProjectionTransform[0][2], viewProjectionTransform[1][2], viewProjectionTransform[2][2], viewProjectionTransform[3][2]);
+	vector4 row3(viewProjectionTransform[0][3], viewProjectionTransform[1][3], viewProjectionTransform[2][3], viewProjectionTransform[3][3]);
+
+	m_planes[0] = row3 + row0;
+	m_planes[1] = row3 - row0;
+	m_planes[2] = row3 + row1;
+	m_planes[3] = row3 - row1;
+	m_planes[4] = row3 + row2;
+	m_planes[5] = row3 - row2;
+
+	for (vector4& plane : m_planes)
+		plane /= glm::length(vector3(plane));
+}
+
+bool Frustum::isPointInside(const vector3 & point) const
+{
+	return isSphereIntersecting(point, 0.0f);
+}
+
+bool Frustum::isSphereIntersecting(const vector3 & center, float radius) const
+{
+	for (const vector4& plane : m_planes) {
+		if (glm::dot(vector3(plane), center) + plane.w < -radius)
+			return false;
+	}
+
+	return true;
+}
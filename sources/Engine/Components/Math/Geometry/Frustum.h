@@ -0,0 +1,19 @@
+#pragma once
+
+#include <Engine\Components\Math\types.h>
+
+class Frustum {
+public:
+	Frustum();
+	Frustum(const matrix4& viewProjectionTransform);
+	~Frustum();
+
+	void setViewProjectionTransform(const matrix4& viewProjectionTransform);
+
+	bool isPointInside(const vector3& point) const;
+	bool isSphereIntersecting(const vector3& center, float radius) const;
+
+private:
+	// Planes are stored as (normal, distance) with normals pointing inside the frustum
+	vector4 m_planes[6];
+};
@@ -1,12 +1,60 @@
 #include "Transform.h"
 
+#include <Engine\assertions.h>
+
+#include <algorithm>
+
 Transform::Transform()
 	: m_scale(1.0f, 1.0f, 1.0f),
 	m_fixedYAxis(false),
 	m_orientation(quaternion()),
-	m_position(0.0f, 0.0f, 0.0f)
+	m_position(0.0f, 0.0f, 0.0f),
+	m_parent(nullptr),
+	m_depth(0),
+	m_localMatrix(1.0f),
+	m_worldMatrix(1.0f),
+	m_isLocalMatrixOutdated(false),
+	m_isWorldMatrixOutdated(false)
+{
+
+}
+
+Transform::Transform(const Transform & transform)
+	: m_scale(transform.m_scale),
+	m_fixedYAxis(transform.m_fixedYAxis),
+	m_orientation(transform.m_orientation),
+	m_position(transform.m_position),
+	m_parent(nullptr),
+	m_depth(0),
+	m_localMatrix(1.0f),
+	m_worldMatrix(1.0f),
+	m_isLocalMatrixOutdated(true),
+	m_isWorldMatrixOutdated(true)
+{
+}
+
+Transform::~Transform()
+{
+	setParent(nullptr);
+
+	// The children stay where they are relative to the world origin now
+	for (Transform* child : m_children) {
+		child->m_parent = nullptr;
+		child->updateDepth(0);
+		child->invalidateWorldMatrix();
+	}
+}
+
+Transform & Transform::operator=(const Transform & transform)
 {
+	m_position = transform.m_position;
+	m_scale = transform.m_scale;
+	m_orientation = transform.m_orientation;
+	m_fixedYAxis = transform.m_fixedYAxis;
 
+	invalidateLocalMatrix();
+
+	return *this;
 }
 
 void Transform::move(float x, float y, float z)
@@ -17,6 +65,7 @@ void Transform::move(float x, float y, float z)
 void Transform::move(vector3 movement)
 {
 	m_position += movement;
+	invalidateLocalMatrix();
 }
 
 void Transform::setPosition(float x, float y, float z)
@@ -27,6 +76,7 @@ void Transform::setPosition(float x, float y, float z)
 void Transform::setPosition(const vector3& position)
 {
 	m_position = position;
+	invalidateLocalMatrix();
 }
 
 vector3 Transform::getPosition() const
@@ -42,6 +92,7 @@ void Transform::scale(float x, float y, float z)
 void Transform::scale(const vector3& scale)
 {
 	m_scale *= scale;
+	invalidateLocalMatrix();
 }
 
 void Transform::setScale(float x, float y, float z)
@@ -52,6 +103,7 @@ void Transform::setScale(float x, float y, float z)
 void Transform::setScale(const vector3& scale)
 {
 	m_scale = scale;
+	invalidateLocalMatrix();
 }
 
 vector3 Transform::getScale() const
@@ -68,11 +120,14 @@ void Transform::rotate(const vector3& axis, float angle)
 {
 	m_orientation *= glm::angleAxis(glm::radians(angle), axis);
 	m_orientation = glm::normalize(m_orientation);
+
+	invalidateLocalMatrix();
 }
 
 void Transform::setOrientation(const quaternion& orientation)
 {
 	m_orientation = orientation;
+	invalidateLocalMatrix();
 }
 
 quaternion Transform::getOrientation() const
@@ -112,6 +167,8 @@ void Transform::yaw(float angle)
 	}
 
 	m_orientation = glm::normalize(m_orientation);
+
+	invalidateLocalMatrix();
 }
 
 void Transform::pitch(float angle)
@@ -149,9 +206,101 @@ void Transform::lookAt(const vector3& target)
 	m[1] = glm::cross(m[2], m[0]);
 
 	m_orientation = quat_cast(m);
+
+	invalidateLocalMatrix();
 }
 
-matrix4 Transform::getTransformationMatrix() const
+void Transform::setParent(Transform * parent)
 {
-	return glm::translate(matrix4(), m_position) * glm::toMat4(m_orientation) * glm::scale(matrix4(), m_scale);
+	if (parent == m_parent)
+		return;
+
+	// The transform can't be placed relative to itself
+	for (Transform* ancestor = parent; ancestor != nullptr; ancestor = ancestor->m_parent)
+		_assert(ancestor != this);
+
+	if (m_parent != nullptr)
+		m_parent->m_children.erase(std::find(m_parent->m_children.begin(), m_parent->m_children.end(), this));
+
+	m_parent = parent;
+
+	if (m_parent != nullptr)
+		m_parent->m_children.push_back(this);
+
+	updateDepth((m_parent != nullptr) ? m_parent->m_depth + 1 : 0);
+	invalidateWorldMatrix();
+}
+
+Transform * Transform::getParent() const
+{
+	return m_parent;
+}
+
+const std::vector<Transform*>& Transform::getChildren() const
+{
+	return m_children;
+}
+
+size_t Transform::getDepth() const
+{
+	return m_depth;
+}
+
+vector3 Transform::getWorldPosition() const
+{
+	if (m_parent == nullptr)
+		return m_position;
+
+	return vector3(getTransformationMatrix()[3]);
+}
+
+const matrix4 & Transform::getLocalMatrix() const
+{
+	if (m_isLocalMatrixOutdated) {
+		m_localMatrix = glm::translate(matrix4(), m_position) * glm::toMat4(m_orientation) * glm::scale(matrix4(), m_scale);
+		m_isLocalMatrixOutdated = false;
+	}
+
+	return m_localMatrix;
+}
+
+const matrix4 & Transform::getTransformationMatrix() const
+{
+	if (m_isWorldMatrixOutdated) {
+		m_worldMatrix = (m_parent != nullptr) ? m_parent->getTransformationMatrix() * getLocalMatrix() : getLocalMatrix();
+		m_isWorldMatrixOutdated = false;
+	}
+
+	return m_worldMatrix;
+}
+
+bool Transform::isWorldMatrixOutdated() const
+{
+	return m_isWorldMatrixOutdated;
+}
+
+void Transform::invalidateLocalMatrix()
+{
+	m_isLocalMatrixOutdated = true;
+	invalidateWorldMatrix();
+}
+
+void Transform::invalidateWorldMatrix()
+{
+	// The descendants of an outdated transform are outdated too
+	if (m_isWorldMatrixOutdated)
+		return;
+
+	m_isWorldMatrixOutdated = true;
+
+	for (Transform* child : m_children)
+		child->invalidateWorldMatrix();
+}
+
+void Transform::updateDepth(size_t depth)
+{
+	m_depth = depth;
+
+	for (Transform* child : m_children)
+		child->updateDepth(depth + 1);
 }
@@ -2,10 +2,19 @@
 
 #include "types.h"
 
+#include <vector>
+
+// Placement of an object relative to its parent. The matrices are cached, a change of the transform
+// marks the world matrices of its subtree as outdated, and they are computed again on the next request
 class Transform
 {
 public:
 	Transform();
+	Transform(const Transform& transform);
+	~Transform();
+
+	// Copies the placement only, the copy isn't attached to the hierarchy
+	Transform& operator=(const Transform& transform);
 
 	void move(float x, float y, float z);
 	void move(vector3 movement);
@@ -45,11 +54,43 @@ public:
 	void lookAt(float x, float y, float z);
 	void lookAt(const vector3& target);
 
-	matrix4 getTransformationMatrix() const;
+	// The transform is placed relative to the parent, null detaches it
+	void setParent(Transform* parent);
+	Transform* getParent() const;
+	const std::vector<Transform*>& getChildren() const;
+
+	// Number of the ancestors
+	size_t getDepth() const;
+
+	vector3 getWorldPosition() const;
+
+	// Placement relative to the parent
+	const matrix4& getLocalMatrix() const;
+
+	// Placement in the world
+	const matrix4& getTransformationMatrix() const;
+	bool isWorldMatrixOutdated() const;
+
+protected:
+	void invalidateLocalMatrix();
+	void invalidateWorldMatrix();
+
+	void updateDepth(size_t depth);
+
 protected:
 	vector3 m_position;
 	vector3 m_scale;
 	quaternion m_orientation;
 
 	bool m_fixedYAxis;
+
+	Transform* m_parent;
+	std::vector<Transform*> m_children;
+	size_t m_depth;
+
+	mutable matrix4 m_localMatrix;
+	mutable matrix4 m_worldMatrix;
+
+	mutable bool m_isLocalMatrixOutdated;
+	mutable bool m_isWorldMatrixOutdated;
 };
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include "TransformsInterpolator.h"
+
+#include <algorithm>
+
+TransformsInterpolator::TransformsInterpolator()
+{
+}
+
+TransformsInterpolator::~TransformsInterpolator()
+{
+}
+
+void TransformsInterpolator::addTransform(Transform * transform)
+{
+	m_transforms.push_back({ 
+		transform, 
+		transform->getPosition(), transform->getOrientation(),
+		transform->getPosition(), transform->getOrientation()
+	});
+}
+
+void TransformsInterpolator::removeTransform(Transform * transform)
+{
+	m_transforms.erase(std::remove_if(m_transforms.begin(), m_transforms.end(), 
+		[transform](const InterpolatedTransform& interpolatedTransform) {
+		return interpolatedTransform.transform == transform;
+	}), m_transforms.end());
+}
+
+void TransformsInterpolator::savePreviousStates()
+{
+	for (InterpolatedTransform& interpolatedTransform : m_transforms) {
+		interpolatedTransform.previousPosition = interpolatedTransform.transform->getPosition();
+		interpolatedTransform.previousOrientation = interpolatedTransform.transform->getOrientation();
+	}
+}
+
+void TransformsInterpolator::applyInterpolation(float interpolationFactor)
+{
+	for (InterpolatedTransform& interpolatedTransform : m_transforms) {
+		Transform* transform = interpolatedTransform.transform;
+
+		interpolatedTransform.currentPosition = transform->getPosition();
+		interpolatedTransform.currentOrientation = transform->getOrientation();
+
+		transform->setPosition(glm::mix(interpolatedTransform.previousPosition, 
+			interpolatedTransform.currentPosition, interpolationFactor));
+		transform->setOrientation(glm::slerp(interpolatedTransform.previousOrientation, 
+			interpolatedTransform.currentOrientation, interpolationFactor));
+	}
+}
+
+void TransformsInterpolator::restoreCurrentStates()
+{
+	for (InterpolatedTransform& interpolatedTransform : m_transforms) {
+		interpolatedTransform.transform->setPosition(interpolatedTransform.currentPosition);
+		interpolatedTransform.transform->setOrientation(interpolatedTransform.currentOrientation);
+	}
+}
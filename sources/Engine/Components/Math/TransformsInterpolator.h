@@ -0,0 +1,40 @@
+#pragma once
+
+#include "types.h"
+#include "Transform.h"
+
+#include <vector>
+
+// Places the transforms changed with a fixed update rate between their last two updated states,
+// so the frames rendered between the updates show smooth movement
+class TransformsInterpolator {
+public:
+	TransformsInterpolator();
+	~TransformsInterpolator();
+
+	void addTransform(Transform* transform);
+	void removeTransform(Transform* transform);
+
+	// Should be called before every update, the states of the transforms become the previous ones
+	void savePreviousStates();
+
+	// Moves the transforms between the previous and the current states for rendering
+	void applyInterpolation(float interpolationFactor);
+
+	// Returns the transforms to the current states after rendering
+	void restoreCurrentStates();
+
+private:
+	struct InterpolatedTransform {
+		Transform* transform;
+
+		vector3 previousPosition;
+		quaternion previousOrientation;
+
+		vector3 currentPosition;
+		quaternion currentOrientation;
+	};
+
+private:
+	std::vector<InterpolatedTransform> m_transforms;
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <Engine\Components\Memory\FrameArena.h>
+
+#include <vector>
+#include <string>
+
+// STL allocator taking the memory from the frame arena of the calling thread.
+// Containers using it are valid until the end of the frame and shouldn't be kept in the objects
+template<class T>
+class FrameAllocator {
+public:
+	using value_type = T;
+
+public:
+	FrameAllocator();
+
+	template<class U>
+	FrameAllocator(const FrameAllocator<U>& allocator);
+
+	T* allocate(size_t count);
+	void deallocate(T* pointer, size_t count);
+};
+
+template<class T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+using FrameString = std::basic_string<char, std::char_traits<char>, FrameAllocator<char>>;
+
+template<class T>
+inline FrameAllocator<T>::FrameAllocator()
+{
+}
+
+template<class T>
+template<class U>
+inline FrameAllocator<T>::FrameAllocator(const FrameAllocator<U>& allocator)
+{
+}
+
+template<class T>
+inline T * FrameAllocator<T>::allocate(size_t count)
+{
+	return static_cast<T*>(FrameArena::getThreadArena().allocate(count * sizeof(T), alignof(T)));
+}
+
+template<class T>
+inline void FrameAllocator<T>::deallocate(T * pointer, size_t count)
+{
+	// The memory is released with the whole arena
+}
+
+// Allocators don't have a state, so the memory of one can be passed to any other
+template<class T, class U>
+inline bool operator==(const FrameAllocator<T>& first, const FrameAllocator<U>& second)
+{
+	return true;
+}
+
+template<class T, class U>
+inline bool operator!=(const FrameAllocator<T>& first, const FrameAllocator<U>& second)
+{
+	return false;
+}
@@ -0,0 +1,118 @@
+#include "FrameArena.h"
+
+#include <Engine\assertions.h>
+
+#include <algorithm>
+#include <cstring>
+
+std::atomic<size_t> FrameArena::s_frameIndex(0);
+std::atomic<size_t> FrameArena::s_peakUsedSize(0);
+
+FrameArena::FrameArena(size_t capacity)
+	: m_buffer(new std::byte[capacity]),
+	m_capacity(capacity),
+	m_offset(0),
+	m_overflowSize(0),
+	m_highWaterMark(0),
+	m_frameIndex(s_frameIndex.load())
+{
+}
+
+FrameArena::~FrameArena()
+{
+	for (void* block : m_overflowBlocks)
+		::operator delete(block);
+
+	delete[] m_buffer;
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment)
+{
+	// The buffer and the heap blocks are aligned for any fundamental type
+	_assert(alignment <= alignof(std::max_align_t) && (alignment & (alignment - 1)) == 0);
+
+	size_t alignedOffset = (m_offset + alignment - 1) & ~(alignment - 1);
+
+	if (alignedOffset + size <= m_capacity) {
+		m_offset = alignedOffset + size;
+
+		return m_buffer + alignedOffset;
+	}
+
+	void* block = ::operator new(size);
+
+	m_overflowBlocks.push_back(block);
+	m_overflowSize += size;
+
+	return block;
+}
+
+void FrameArena::reset()
+{
+	size_t usedSize = getUsedSize();
+	m_highWaterMark = std::max(m_highWaterMark, usedSize);
+
+	size_t peakUsedSize = s_peakUsedSize.load();
+
+	while (usedSize > peakUsedSize && !s_peakUsedSize.compare_exchange_weak(peakUsedSize, usedSize)) {
+	}
+
+#ifdef _DEBUG
+	std::memset(m_buffer, POISON_BYTE, m_offset);
+#endif
+
+	for (void* block : m_overflowBlocks)
+		::operator delete(block);
+
+	m_overflowBlocks.clear();
+
+	// The next frames like this one fit into the buffer
+	if (m_overflowSize != 0) {
+		delete[] m_buffer;
+
+		m_capacity = std::max(m_capacity * 2, usedSize);
+		m_buffer = new std::byte[m_capacity];
+	}
+
+	m_offset = 0;
+	m_overflowSize = 0;
+}
+
+size_t FrameArena::getCapacity() const
+{
+	return m_capacity;
+}
+
+size_t FrameArena::getUsedSize() const
+{
+	return m_offset + m_overflowSize;
+}
+
+size_t FrameArena::getHighWaterMark() const
+{
+	return std::max(m_highWaterMark, getUsedSize());
+}
+
+FrameArena & FrameArena::getThreadArena()
+{
+	static thread_local FrameArena arena(DEFAULT_CAPACITY);
+
+	size_t frameIndex = s_frameIndex.load();
+
+	if (arena.m_frameIndex != frameIndex) {
+		arena.reset();
+		arena.m_frameIndex = frameIndex;
+	}
+
+	return arena;
+}
+
+void FrameArena::startNewFrame()
+{
+	s_frameIndex++;
+}
+
+size_t FrameArena::getPeakUsedSize()
+{
+	return s_peakUsedSize.load();
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <Engine\types.h>
+
+#include <vector>
+#include <atomic>
+#include <cstddef>
+
+// Linear allocator for the temporary data of one frame. Allocation moves the offset in the buffer,
+// deallocation does nothing, and the whole arena is released when the next frame starts.
+// Every thread has its own arena, so allocations don't contend for the heap lock
+class FrameArena {
+public:
+	FrameArena(size_t capacity);
+	~FrameArena();
+
+	void* allocate(size_t size, size_t alignment);
+
+	// Frees all allocations, the buffer grows if the previous frame didn't fit into it
+	void reset();
+
+	size_t getCapacity() const;
+	size_t getUsedSize() const;
+
+	// The largest used size of the frames since the arena creation
+	size_t getHighWaterMark() const;
+
+public:
+	// Arena of the calling thread, it is reset on the first use in a new frame
+	static FrameArena& getThreadArena();
+
+	// Should be called when no temporary data of the previous frame is alive and no jobs are running
+	static void startNewFrame();
+
+	// The largest frame used size among the arenas of all threads
+	static size_t getPeakUsedSize();
+
+private:
+	FrameArena(const FrameArena& arena) = delete;
+	FrameArena& operator=(const FrameArena& arena) = delete;
+
+private:
+	static const size_t DEFAULT_CAPACITY = 1024 * 1024;
+
+	// Freed memory is filled in the debug builds, so data kept beyond the frame is noticed at once
+	static const int POISON_BYTE = 0xCD;
+
+private:
+	std::byte* m_buffer;
+	size_t m_capacity;
+	size_t m_offset;
+
+	// Allocations not fitting into the buffer are taken from the heap until the next reset
+	std::vector<void*> m_overflowBlocks;
+	size_t m_overflowSize;
+
+	size_t m_highWaterMark;
+
+	size_t m_frameIndex;
+
+private:
+	static std::atomic<size_t> s_frameIndex;
+	static std::atomic<size_t> s_peakUsedSize;
+};
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <Engine\assertions.h>
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <new>
+
+// Storage of objects of one type in fixed-size chunks. Objects of a chunk lie in one contiguous block,
+// freed slots are reused by the next created objects. Chunks are never moved, so the addresses
+// and the indices of the objects stay valid until they are destroyed
+template<class T, size_t CHUNK_SIZE = 64>
+class ObjectsPool {
+public:
+	ObjectsPool();
+	~ObjectsPool();
+
+	template<class... Args>
+	T* create(Args&&... args);
+	void destroy(T* object);
+
+	// Returns null if the slot is free
+	T* get(size_t index) const;
+	size_t getIndex(const T* object) const;
+
+	// Number of the alive objects
+	size_t getSize() const;
+	size_t getCapacity() const;
+
+	// Visits the alive objects in the storage order
+	template<class Function>
+	void forEach(const Function& function) const;
+
+private:
+	ObjectsPool(const ObjectsPool& pool) = delete;
+	ObjectsPool& operator=(const ObjectsPool& pool) = delete;
+
+private:
+	struct Chunk {
+		alignas(T) std::byte storage[sizeof(T) * CHUNK_SIZE];
+		bool isAlive[CHUNK_SIZE];
+	};
+
+private:
+	T* getSlot(size_t index) const;
+
+private:
+	std::vector<Chunk*> m_chunks;
+
+	// The last freed slot is reused first, its memory is the most likely to be in the cache
+	std::vector<size_t> m_freeIndices;
+
+	size_t m_size;
+};
+
+template<class T, size_t CHUNK_SIZE>
+inline ObjectsPool<T, CHUNK_SIZE>::ObjectsPool()
+	: m_size(0)
+{
+}
+
+template<class T, size_t CHUNK_SIZE>
+inline ObjectsPool<T, CHUNK_SIZE>::~ObjectsPool()
+{
+	forEach([](T* object) { object->~T(); });
+
+	for (Chunk* chunk : m_chunks)
+		delete chunk;
+}
+
+template<class T, size_t CHUNK_SIZE>
+template<class... Args>
+inline T * ObjectsPool<T, CHUNK_SIZE>::create(Args&&... args)
+{
+	if (m_freeIndices.empty()) {
+		size_t firstIndex = m_chunks.size() * CHUNK_SIZE;
+
+		Chunk* chunk = new Chunk();
+		m_chunks.push_back(chunk);
+
+		for (size_t offset = CHUNK_SIZE; offset > 0; offset--)
+			m_freeIndices.push_back(firstIndex + offset - 1);
+	}
+
+	size_t index = m_freeIndices.back();
+	T* object = new (getSlot(index)) T(std::forward<Args>(args)...);
+
+	m_freeIndices.pop_back();
+	m_chunks[index / CHUNK_SIZE]->isAlive[index % CHUNK_SIZE] = true;
+	m_size++;
+
+	return object;
+}
+
+template<class T, size_t CHUNK_SIZE>
+inline void ObjectsPool<T, CHUNK_SIZE>::destroy(T * object)
+{
+	size_t index = getIndex(object);
+	bool& isAlive = m_chunks[index / CHUNK_SIZE]->isAlive[index % CHUNK_SIZE];
+
+	_assert(isAlive);
+
+	object->~T();
+
+	isAlive = false;
+	m_freeIndices.push_back(index);
+	m_size--;
+}
+
+template<class T, size_t CHUNK_SIZE>
+inline T * ObjectsPool<T, CHUNK_SIZE>::get(size_t index) const
+{
+	_assert(index < getCapacity());
+
+	if (!m_chunks[index / CHUNK_SIZE]->isAlive[index % CHUNK_SIZE])
+		return nullptr;
+
+	return getSlot(index);
+}
+
+template<class T, size_t CHUNK_SIZE>
+inline size_t ObjectsPool<T, CHUNK_SIZE>::getIndex(const T * object) const
+{
+	const std::byte* address = reinterpret_cast<const std::byte*>(object);
+
+	for (size_t chunkIndex = 0; chunkIndex < m_chunks.size(); chunkIndex++) {
+		const std::byte* storage = m_chunks[chunkIndex]->storage;
+
+		if (address >= storage && address < storage + sizeof(Chunk::storage))
+			return chunkIndex * CHUNK_SIZE + (address - storage) / sizeof(T);
+	}
+
+	// The object doesn't belong to the pool
+	_assert(false);
+
+	return 0;
+}
+
+template<class T, size_t CHUNK_SIZE>
+inline size_t ObjectsPool<T, CHUNK_SIZE>::getSize() const
+{
+	return m_size;
+}
+
+template<class T, size_t CHUNK_SIZE>
+inline size_t ObjectsPool<T, CHUNK_SIZE>::getCapacity() const
+{
+	return m_chunks.size() * CHUNK_SIZE;
+}
+
+template<class T, size_t CHUNK_SIZE>
+template<class Function>
+inline void ObjectsPool<T, CHUNK_SIZE>::forEach(const Function & function) const
+{
+	for (Chunk* chunk : m_chunks) {
+		T* objects = reinterpret_cast<T*>(chunk->storage);
+
+		for (size_t offset = 0; offset < CHUNK_SIZE; offset++) {
+			if (chunk->isAlive[offset])
+				function(objects + offset);
+		}
+	}
+}
+
+template<class T, size_t CHUNK_SIZE>
+inline T * ObjectsPool<T, CHUNK_SIZE>::getSlot(size_t index) const
+{
+	return reinterpret_cast<T*>(m_chunks[index / CHUNK_SIZE]->storage) + index % CHUNK_SIZE;
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <Engine\types.h>
+#include <Engine\assertions.h>
+
+#include <vector>
+#include <utility>
+
+// Reference to an item of a slot map. The generation of the slot is changed when the item is removed,
+// so the old handles stop matching it. The default handle never matches any item
+struct SlotMapHandle {
+	uint32 index = 0;
+	uint32 generation = 0;
+
+	bool operator==(const SlotMapHandle& handle) const;
+	bool operator!=(const SlotMapHandle& handle) const;
+};
+
+// Items are kept densely in one array and are found by the handles through the slots.
+// Insertion and removal take constant time, the removed item is replaced by the last one,
+// so the order of the items isn't kept
+template<class T>
+class SlotMap {
+public:
+	using Handle = SlotMapHandle;
+
+public:
+	SlotMap();
+	~SlotMap();
+
+	Handle insert(const T& value);
+	void remove(Handle handle);
+
+	bool contains(Handle handle) const;
+
+	// Returns null for the stale handles
+	T* get(Handle handle);
+	const T* get(Handle handle) const;
+
+	const std::vector<T>& getValues() const;
+	size_t getSize() const;
+
+private:
+	struct Slot {
+		uint32 valueIndex;
+		uint32 generation;
+	};
+
+private:
+	std::vector<Slot> m_slots;
+	std::vector<uint32> m_freeSlots;
+
+	std::vector<T> m_values;
+
+	// Slot of every value, it is needed to fix the slot of the value moved by the removal
+	std::vector<uint32> m_valuesSlots;
+};
+
+inline bool SlotMapHandle::operator==(const SlotMapHandle & handle) const
+{
+	return index == handle.index && generation == handle.generation;
+}
+
+inline bool SlotMapHandle::operator!=(const SlotMapHandle & handle) const
+{
+	return !(*this == handle);
+}
+
+template<class T>
+inline SlotMap<T>::SlotMap()
+{
+}
+
+template<class T>
+inline SlotMap<T>::~SlotMap()
+{
+}
+
+template<class T>
+inline typename SlotMap<T>::Handle SlotMap<T>::insert(const T & value)
+{
+	uint32 slotIndex;
+
+	if (m_freeSlots.empty()) {
+		slotIndex = static_cast<uint32>(m_slots.size());
+
+		// Generations start from one, the default handle stays invalid
+		m_slots.push_back({ 0, 1 });
+	}
+	else {
+		slotIndex = m_freeSlots.back();
+		m_freeSlots.pop_back();
+	}
+
+	Slot& slot = m_slots[slotIndex];
+	slot.valueIndex = static_cast<uint32>(m_values.size());
+
+	m_values.push_back(value);
+	m_valuesSlots.push_back(slotIndex);
+
+	Handle handle;
+	handle.index = slotIndex;
+	handle.generation = slot.generation;
+
+	return handle;
+}
+
+template<class T>
+inline void SlotMap<T>::remove(Handle handle)
+{
+	_assert(contains(handle));
+
+	Slot& slot = m_slots[handle.index];
+	uint32 lastValueIndex = static_cast<uint32>(m_values.size() - 1);
+
+	if (slot.valueIndex != lastValueIndex) {
+		m_values[slot.valueIndex] = std::move(m_values[lastValueIndex]);
+		m_valuesSlots[slot.valueIndex] = m_valuesSlots[lastValueIndex];
+
+		m_slots[m_valuesSlots[slot.valueIndex]].valueIndex = slot.valueIndex;
+	}
+
+	m_values.pop_back();
+	m_valuesSlots.pop_back();
+
+	slot.generation++;
+
+	if (slot.generation == 0)
+		slot.generation = 1;
+
+	m_freeSlots.push_back(handle.index);
+}
+
+template<class T>
+inline bool SlotMap<T>::contains(Handle handle) const
+{
+	return handle.generation != 0 && handle.index < m_slots.size() &&
+		m_slots[handle.index].generation == handle.generation;
+}
+
+template<class T>
+inline T * SlotMap<T>::get(Handle handle)
+{
+	if (!contains(handle))
+		return nullptr;
+
+	return &m_values[m_slots[handle.index].valueIndex];
+}
+
+template<class T>
+inline const T * SlotMap<T>::get(Handle handle) const
+{
+	if (!contains(handle))
+		return nullptr;
+
+	return &m_values[m_slots[handle.index].valueIndex];
+}
+
+template<class T>
+inline const std::vector<T>& SlotMap<T>::getValues() const
+{
+	return m_values;
+}
+
+template<class T>
+inline size_t SlotMap<T>::getSize() const
+{
+	return m_values.size();
+}
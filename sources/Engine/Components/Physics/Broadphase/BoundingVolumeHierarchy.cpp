@@ -0,0 +1,213 @@
+#include "BoundingVolumeHierarchy.h"
+
+#include <Engine/assertions.h>
+
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(const std::vector<AABB>& itemsBounds)
+{
+	if (itemsBounds.empty())
+		return;
+
+	std::vector<vector3> itemsCenters;
+	itemsCenters.reserve(itemsBounds.size());
+
+	m_itemsIndices.reserve(itemsBounds.size());
+
+	for (size_t itemIndex = 0; itemIndex < itemsBounds.size(); itemIndex++) {
+		itemsCenters.push_back(itemsBounds[itemIndex].getCenter());
+		m_itemsIndices.push_back(itemIndex);
+	}
+
+	m_nodes.reserve(2 * itemsBounds.size() / MAX_LEAF_ITEMS_COUNT + 1);
+
+	buildNode(itemsBounds, itemsCenters, 0, itemsBounds.size());
+
+	m_itemsBounds.reserve(itemsBounds.size());
+
+	for (uint32 itemIndex : m_itemsIndices)
+		m_itemsBounds.push_back(itemsBounds[itemIndex]);
+}
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(const std::vector<Node>& nodes, const std::vector<uint32>& itemsIndices, 
+	const std::vector<AABB>& itemsBounds)
+	: m_nodes(nodes), m_itemsIndices(itemsIndices)
+{
+	_assert(itemsIndices.size() == itemsBounds.size());
+
+	m_itemsBounds.reserve(itemsBounds.size());
+
+	for (uint32 itemIndex : m_itemsIndices)
+		m_itemsBounds.push_back(itemsBounds[itemIndex]);
+}
+
+BoundingVolumeHierarchy::~BoundingVolumeHierarchy()
+{
+}
+
+void BoundingVolumeHierarchy::buildNode(const std::vector<AABB>& itemsBounds, const std::vector<vector3>& itemsCenters, 
+	size_t begin, size_t end)
+{
+	size_t nodeIndex = m_nodes.size();
+	m_nodes.push_back(Node());
+
+	AABB nodeBounds = itemsBounds[m_itemsIndices[begin]];
+	AABB centersBounds(itemsCenters[m_itemsIndices[begin]], itemsCenters[m_itemsIndices[begin]]);
+
+	for (size_t i = begin + 1; i < end; i++) {
+		const vector3& center = itemsCenters[m_itemsIndices[i]];
+
+		nodeBounds.merge(itemsBounds[m_itemsIndices[i]]);
+		centersBounds.merge(AABB(center, center));
+	}
+
+	m_nodes[nodeIndex].bounds = nodeBounds;
+
+	if (end - begin <= MAX_LEAF_ITEMS_COUNT) {
+		m_nodes[nodeIndex].firstItemIndex = begin;
+		m_nodes[nodeIndex].itemsCount = end - begin;
+		m_nodes[nodeIndex].secondChildIndex = 0;
+
+		return;
+	}
+
+	// Median split along the longest extent of the items centers
+	vector3 centersSize = centersBounds.getSize();
+	int splitAxis = 0;
+
+	if (centersSize.y > centersSize[splitAxis])
+		splitAxis = 1;
+
+	if (centersSize.z > centersSize[splitAxis])
+		splitAxis = 2;
+
+	size_t middle = begin + (end - begin) / 2;
+
+	std::nth_element(m_itemsIndices.begin() + begin, m_itemsIndices.begin() + middle, m_itemsIndices.begin() + end,
+		[&itemsCenters, splitAxis](uint32 first, uint32 second) {
+			return itemsCenters[first][splitAxis] < itemsCenters[second][splitAxis];
+		});
+
+	buildNode(itemsBounds, itemsCenters, begin, middle);
+
+	m_nodes[nodeIndex].firstItemIndex = 0;
+	m_nodes[nodeIndex].itemsCount = 0;
+	m_nodes[nodeIndex].secondChildIndex = m_nodes.size();
+
+	buildNode(itemsBounds, itemsCenters, middle, end);
+}
+
+void BoundingVolumeHierarchy::query(const AABB & bounds, std::vector<size_t>& items) const
+{
+	if (m_nodes.empty())
+		return;
+
+	uint32 stack[MAX_TRAVERSAL_DEPTH];
+	size_t stackSize = 0;
+
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0) {
+		const Node& node = m_nodes[stack[--stackSize]];
+
+		if (!node.bounds.intersects(bounds))
+			continue;
+
+		if (node.itemsCount > 0) {
+			for (size_t i = node.firstItemIndex; i < node.firstItemIndex + node.itemsCount; i++) {
+				if (m_itemsBounds[i].intersects(bounds))
+					items.push_back(m_itemsIndices[i]);
+			}
+
+			continue;
+		}
+
+		_assert(stackSize + 2 <= MAX_TRAVERSAL_DEPTH);
+
+		uint32 nodeIndex = (uint32)(&node - m_nodes.data());
+
+		stack[stackSize++] = node.secondChildIndex;
+		stack[stackSize++] = nodeIndex + 1;
+	}
+}
+
+void BoundingVolumeHierarchy::query(const Ray & ray, float maxDistance, std::vector<size_t>& items) const
+{
+	if (m_nodes.empty())
+		return;
+
+	uint32 stack[MAX_TRAVERSAL_DEPTH];
+	size_t stackSize = 0;
+
+	stack[stackSize++] = 0;
+
+	vector3 rayOrigin = ray.getOrigin();
+	vector3 inverseRayDirection = 1.0f / ray.getDirection();
+
+	while (stackSize > 0) {
+		const Node& node = m_nodes[stack[--stackSize]];
+
+		if (!isRaySegmentIntersecting(node.bounds, rayOrigin, inverseRayDirection, maxDistance))
+			continue;
+
+		if (node.itemsCount > 0) {
+			for (size_t i = node.firstItemIndex; i < node.firstItemIndex + node.itemsCount; i++) {
+				if (isRaySegmentIntersecting(m_itemsBounds[i], rayOrigin, inverseRayDirection, maxDistance))
+					items.push_back(m_itemsIndices[i]);
+			}
+
+			continue;
+		}
+
+		_assert(stackSize + 2 <= MAX_TRAVERSAL_DEPTH);
+
+		uint32 nodeIndex = (uint32)(&node - m_nodes.data());
+
+		stack[stackSize++] = node.secondChildIndex;
+		stack[stackSize++] = nodeIndex + 1;
+	}
+}
+
+bool BoundingVolumeHierarchy::isRaySegmentIntersecting(const AABB & bounds, const vector3 & rayOrigin, 
+	const vector3 & inverseRayDirection, float maxDistance)
+{
+	vector3 t0 = (bounds.getMin() - rayOrigin) * inverseRayDirection;
+	vector3 t1 = (bounds.getMax() - rayOrigin) * inverseRayDirection;
+
+	vector3 tMin, tMax;
+
+	for (int axis = 0; axis < 3; axis++) {
+		// Origin lying in the plane of a box side with zero direction component gives 0 * inf = NaN,
+		// such ray goes along the side and stays in the slab all the way
+		if (std::isnan(t0[axis]) || std::isnan(t1[axis])) {
+			tMin[axis] = -std::numeric_limits<float>::infinity();
+			tMax[axis] = std::numeric_limits<float>::infinity();
+		}
+		else {
+			tMin[axis] = std::min(t0[axis], t1[axis]);
+			tMax[axis] = std::max(t0[axis], t1[axis]);
+		}
+	}
+
+	float tNear = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+	float tFar = std::min(std::min(tMax.x, tMax.y), std::min(tMax.z, maxDistance));
+
+	return tNear <= tFar;
+}
+
+const std::vector<BoundingVolumeHierarchy::Node>& BoundingVolumeHierarchy::getNodes() const
+{
+	return m_nodes;
+}
+
+const std::vector<uint32>& BoundingVolumeHierarchy::getItemsIndices() const
+{
+	return m_itemsIndices;
+}
+
+bool BoundingVolumeHierarchy::isEmpty() const
+{
+	return m_nodes.empty();
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <Engine/types.h>
+#include <Engine/Components/Physics/Colliders/AABB.h>
+#include <Engine/Components/Physics/Ray.h>
+
+#include <vector>
+
+// Static bounding volume hierarchy, built once and stored in a flat depth-first array.
+// The first child of a node is always the next node, so only the second child index is kept
+class BoundingVolumeHierarchy {
+public:
+	struct Node {
+		AABB bounds;
+
+		// Leaf nodes refer to the range of items indices, inner nodes have zero items
+		uint32 firstItemIndex;
+		uint32 itemsCount;
+
+		uint32 secondChildIndex;
+	};
+
+public:
+	BoundingVolumeHierarchy(const std::vector<AABB>& itemsBounds);
+	BoundingVolumeHierarchy(const std::vector<Node>& nodes, const std::vector<uint32>& itemsIndices, 
+		const std::vector<AABB>& itemsBounds);
+	~BoundingVolumeHierarchy();
+
+	// Appends indices of the items whose bounds intersect the box or the ray
+	void query(const AABB& bounds, std::vector<size_t>& items) const;
+	void query(const Ray& ray, float maxDistance, std::vector<size_t>& items) const;
+
+	const std::vector<Node>& getNodes() const;
+	const std::vector<uint32>& getItemsIndices() const;
+
+	bool isEmpty() const;
+
+public:
+	static const size_t MAX_LEAF_ITEMS_COUNT = 4;
+
+	// Traversal uses a fixed stack, the hierarchy depth is limited by the median split
+	static const size_t MAX_TRAVERSAL_DEPTH = 64;
+
+private:
+	void buildNode(const std::vector<AABB>& itemsBounds, const std::vector<vector3>& itemsCenters, 
+		size_t begin, size_t end);
+
+	// Checks whether the ray segment [0, maxDistance] passes through the box
+	static bool isRaySegmentIntersecting(const AABB& bounds, const vector3& rayOrigin, 
+		const vector3& inverseRayDirection, float maxDistance);
+
+private:
+	std::vector<Node> m_nodes;
+	std::vector<uint32> m_itemsIndices;
+
+	// Items bounds in the same order as the indices, so leaves read them sequentially
+	std::vector<AABB> m_itemsBounds;
+};
@@ -0,0 +1,58 @@
+#include "Broadphase.h"
+
+Broadphase::Broadphase(float dynamicBoundsMargin)
+	: m_staticHierarchy(nullptr),
+	m_dynamicTree(dynamicBoundsMargin)
+{
+}
+
+Broadphase::~Broadphase()
+{
+}
+
+void Broadphase::setStaticHierarchy(const BoundingVolumeHierarchy * hierarchy)
+{
+	m_staticHierarchy = hierarchy;
+}
+
+const BoundingVolumeHierarchy * Broadphase::getStaticHierarchy() const
+{
+	return m_staticHierarchy;
+}
+
+Broadphase::ProxyId Broadphase::addDynamicCollider(const AABB & bounds, void * userData)
+{
+	return m_dynamicTree.createProxy(bounds, userData);
+}
+
+void Broadphase::updateDynamicCollider(ProxyId proxyId, const AABB & bounds)
+{
+	m_dynamicTree.moveProxy(proxyId, bounds);
+}
+
+void Broadphase::removeDynamicCollider(ProxyId proxyId)
+{
+	m_dynamicTree.destroyProxy(proxyId);
+}
+
+void * Broadphase::getUserData(ProxyId proxyId) const
+{
+	return m_dynamicTree.getUserData(proxyId);
+}
+
+void Broadphase::queryStaticColliders(const AABB & bounds, std::vector<size_t>& colliders) const
+{
+	if (m_staticHierarchy != nullptr)
+		m_staticHierarchy->query(bounds, colliders);
+}
+
+void Broadphase::queryStaticColliders(const Ray & ray, float maxDistance, std::vector<size_t>& colliders) const
+{
+	if (m_staticHierarchy != nullptr)
+		m_staticHierarchy->query(ray, maxDistance, colliders);
+}
+
+void Broadphase::queryDynamicColliders(const AABB & bounds, std::vector<ProxyId>& proxies) const
+{
+	m_dynamicTree.query(bounds, proxies);
+}
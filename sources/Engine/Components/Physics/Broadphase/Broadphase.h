@@ -0,0 +1,33 @@
+#pragma once
+
+#include "BoundingVolumeHierarchy.h"
+#include "DynamicBoundingVolumeTree.h"
+
+// Finds collision candidates among static colliders (prebuilt hierarchy of the level)
+// and dynamic ones (incremental tree)
+class Broadphase {
+public:
+	using ProxyId = DynamicBoundingVolumeTree::ProxyId;
+
+public:
+	Broadphase(float dynamicBoundsMargin);
+	~Broadphase();
+
+	void setStaticHierarchy(const BoundingVolumeHierarchy* hierarchy);
+	const BoundingVolumeHierarchy* getStaticHierarchy() const;
+
+	ProxyId addDynamicCollider(const AABB& bounds, void* userData);
+	void updateDynamicCollider(ProxyId proxyId, const AABB& bounds);
+	void removeDynamicCollider(ProxyId proxyId);
+
+	void* getUserData(ProxyId proxyId) const;
+
+	void queryStaticColliders(const AABB& bounds, std::vector<size_t>& colliders) const;
+	void queryStaticColliders(const Ray& ray, float maxDistance, std::vector<size_t>& colliders) const;
+
+	void queryDynamicColliders(const AABB& bounds, std::vector<ProxyId>& proxies) const;
+
+private:
+	const BoundingVolumeHierarchy* m_staticHierarchy;
+	DynamicBoundingVolumeTree m_dynamicTree;
+};
@@ -0,0 +1,321 @@
+#include "DynamicBoundingVolumeTree.h"
+
+#include <Engine/assertions.h>
+
+#include <algorithm>
+
+DynamicBoundingVolumeTree::DynamicBoundingVolumeTree(float boundsMargin)
+	: m_rootId(NULL_PROXY),
+	m_freeListId(NULL_PROXY),
+	m_proxiesCount(0),
+	m_boundsMargin(boundsMargin)
+{
+}
+
+DynamicBoundingVolumeTree::~DynamicBoundingVolumeTree()
+{
+}
+
+DynamicBoundingVolumeTree::ProxyId DynamicBoundingVolumeTree::createProxy(const AABB & bounds, void * userData)
+{
+	ProxyId proxyId = allocateNode();
+
+	m_nodes[proxyId].bounds = bounds;
+	m_nodes[proxyId].bounds.expand(m_boundsMargin);
+	m_nodes[proxyId].userData = userData;
+	m_nodes[proxyId].height = 0;
+
+	insertLeaf(proxyId);
+	m_proxiesCount++;
+
+	return proxyId;
+}
+
+void DynamicBoundingVolumeTree::destroyProxy(ProxyId proxyId)
+{
+	_assert(m_nodes[proxyId].isLeaf());
+
+	removeLeaf(proxyId);
+	freeNode(proxyId);
+
+	m_proxiesCount--;
+}
+
+bool DynamicBoundingVolumeTree::moveProxy(ProxyId proxyId, const AABB & bounds)
+{
+	_assert(m_nodes[proxyId].isLeaf());
+
+	if (m_nodes[proxyId].bounds.contains(bounds))
+		return false;
+
+	removeLeaf(proxyId);
+
+	m_nodes[proxyId].bounds = bounds;
+	m_nodes[proxyId].bounds.expand(m_boundsMargin);
+
+	insertLeaf(proxyId);
+
+	return true;
+}
+
+void * DynamicBoundingVolumeTree::getUserData(ProxyId proxyId) const
+{
+	return m_nodes[proxyId].userData;
+}
+
+const AABB & DynamicBoundingVolumeTree::getFatBounds(ProxyId proxyId) const
+{
+	return m_nodes[proxyId].bounds;
+}
+
+void DynamicBoundingVolumeTree::query(const AABB & bounds, std::vector<ProxyId>& proxies) const
+{
+	if (m_rootId == NULL_PROXY)
+		return;
+
+	// The tree is kept balanced, so its height is logarithmic
+	const size_t MAX_TRAVERSAL_DEPTH = 64;
+
+	ProxyId stack[MAX_TRAVERSAL_DEPTH];
+	size_t stackSize = 0;
+
+	stack[stackSize++] = m_rootId;
+
+	while (stackSize > 0) {
+		const Node& node = m_nodes[stack[--stackSize]];
+
+		if (!node.bounds.intersects(bounds))
+			continue;
+
+		if (node.isLeaf()) {
+			proxies.push_back((ProxyId)(&node - m_nodes.data()));
+			continue;
+		}
+
+		_assert(stackSize + 2 <= MAX_TRAVERSAL_DEPTH);
+
+		stack[stackSize++] = node.secondChild;
+		stack[stackSize++] = node.firstChild;
+	}
+}
+
+size_t DynamicBoundingVolumeTree::getProxiesCount() const
+{
+	return m_proxiesCount;
+}
+
+size_t DynamicBoundingVolumeTree::getHeight() const
+{
+	return (m_rootId == NULL_PROXY) ? 0 : m_nodes[m_rootId].height;
+}
+
+DynamicBoundingVolumeTree::ProxyId DynamicBoundingVolumeTree::allocateNode()
+{
+	ProxyId nodeId;
+
+	if (m_freeListId != NULL_PROXY) {
+		nodeId = m_freeListId;
+		m_freeListId = m_nodes[nodeId].parent;
+	}
+	else {
+		nodeId = (ProxyId)m_nodes.size();
+		m_nodes.push_back(Node());
+	}
+
+	Node& node = m_nodes[nodeId];
+	node.userData = nullptr;
+	node.parent = NULL_PROXY;
+	node.firstChild = NULL_PROXY;
+	node.secondChild = NULL_PROXY;
+	node.height = 0;
+
+	return nodeId;
+}
+
+void DynamicBoundingVolumeTree::freeNode(ProxyId nodeId)
+{
+	m_nodes[nodeId].parent = m_freeListId;
+	m_nodes[nodeId].height = -1;
+
+	m_freeListId = nodeId;
+}
+
+void DynamicBoundingVolumeTree::insertLeaf(ProxyId leafId)
+{
+	if (m_rootId == NULL_PROXY) {
+		m_rootId = leafId;
+		m_nodes[leafId].parent = NULL_PROXY;
+
+		return;
+	}
+
+	AABB leafBounds = m_nodes[leafId].bounds;
+
+	// Descend to the sibling that increases the total surface area the least
+	ProxyId siblingId = m_rootId;
+
+	while (!m_nodes[siblingId].isLeaf()) {
+		const Node& node = m_nodes[siblingId];
+
+		float area = node.bounds.getSurfaceArea();
+		float combinedArea = AABB::merge(node.bounds, leafBounds).getSurfaceArea();
+
+		// Cost of pairing the leaf with this node under a new parent
+		float pairingCost = 2.0f * combinedArea;
+
+		// Cost pushed down to the children when descending further
+		float inheritanceCost = 2.0f * (combinedArea - area);
+
+		float childrenCosts[2];
+		ProxyId children[2] = { node.firstChild, node.secondChild };
+
+		for (size_t childIndex = 0; childIndex < 2; childIndex++) {
+			const Node& child = m_nodes[children[childIndex]];
+			float childCombinedArea = AABB::merge(child.bounds, leafBounds).getSurfaceArea();
+
+			if (child.isLeaf())
+				childrenCosts[childIndex] = childCombinedArea + inheritanceCost;
+			else
+				childrenCosts[childIndex] = childCombinedArea - child.bounds.getSurfaceArea() + inheritanceCost;
+		}
+
+		if (pairingCost < childrenCosts[0] && pairingCost < childrenCosts[1])
+			break;
+
+		siblingId = (childrenCosts[0] < childrenCosts[1]) ? children[0] : children[1];
+	}
+
+	ProxyId oldParentId = m_nodes[siblingId].parent;
+	ProxyId newParentId = allocateNode();
+
+	Node& newParent = m_nodes[newParentId];
+	newParent.parent = oldParentId;
+	newParent.bounds = AABB::merge(leafBounds, m_nodes[siblingId].bounds);
+	newParent.height = m_nodes[siblingId].height + 1;
+	newParent.firstChild = siblingId;
+	newParent.secondChild = leafId;
+
+	if (oldParentId != NULL_PROXY) {
+		if (m_nodes[oldParentId].firstChild == siblingId)
+			m_nodes[oldParentId].firstChild = newParentId;
+		else
+			m_nodes[oldParentId].secondChild = newParentId;
+	}
+	else {
+		m_rootId = newParentId;
+	}
+
+	m_nodes[siblingId].parent = newParentId;
+	m_nodes[leafId].parent = newParentId;
+
+	refitAncestors(newParentId);
+}
+
+void DynamicBoundingVolumeTree::removeLeaf(ProxyId leafId)
+{
+	if (leafId == m_rootId) {
+		m_rootId = NULL_PROXY;
+		return;
+	}
+
+	ProxyId parentId = m_nodes[leafId].parent;
+	ProxyId grandParentId = m_nodes[parentId].parent;
+	ProxyId siblingId = (m_nodes[parentId].firstChild == leafId) ? m_nodes[parentId].secondChild : m_nodes[parentId].firstChild;
+
+	// The sibling takes the place of the parent
+	if (grandParentId != NULL_PROXY) {
+		if (m_nodes[grandParentId].firstChild == parentId)
+			m_nodes[grandParentId].firstChild = siblingId;
+		else
+			m_nodes[grandParentId].secondChild = siblingId;
+
+		m_nodes[siblingId].parent = grandParentId;
+		freeNode(parentId);
+
+		refitAncestors(grandParentId);
+	}
+	else {
+		m_rootId = siblingId;
+		m_nodes[siblingId].parent = NULL_PROXY;
+
+		freeNode(parentId);
+	}
+}
+
+void DynamicBoundingVolumeTree::refitAncestors(ProxyId nodeId)
+{
+	while (nodeId != NULL_PROXY) {
+		nodeId = balance(nodeId);
+
+		Node& node = m_nodes[nodeId];
+		const Node& firstChild = m_nodes[node.firstChild];
+		const Node& secondChild = m_nodes[node.secondChild];
+
+		node.height = 1 + std::max(firstChild.height, secondChild.height);
+		node.bounds = AABB::merge(firstChild.bounds, secondChild.bounds);
+
+		nodeId = node.parent;
+	}
+}
+
+DynamicBoundingVolumeTree::ProxyId DynamicBoundingVolumeTree::balance(ProxyId nodeId)
+{
+	Node& node = m_nodes[nodeId];
+
+	if (node.isLeaf() || node.height < 2)
+		return nodeId;
+
+	ProxyId firstChildId = node.firstChild;
+	ProxyId secondChildId = node.secondChild;
+
+	int32 heightsDifference = m_nodes[secondChildId].height - m_nodes[firstChildId].height;
+
+	if (heightsDifference >= -1 && heightsDifference <= 1)
+		return nodeId;
+
+	// The higher child is rotated up and takes the place of the node,
+	// the node adopts the lower grandchild
+	bool isSecondChildHigher = heightsDifference > 1;
+
+	ProxyId higherChildId = isSecondChildHigher ? secondChildId : firstChildId;
+	ProxyId lowerChildId = isSecondChildHigher ? firstChildId : secondChildId;
+
+	Node& higherChild = m_nodes[higherChildId];
+
+	ProxyId tallerGrandChildId = higherChild.firstChild;
+	ProxyId shorterGrandChildId = higherChild.secondChild;
+
+	if (m_nodes[tallerGrandChildId].height < m_nodes[shorterGrandChildId].height)
+		std::swap(tallerGrandChildId, shorterGrandChildId);
+
+	higherChild.parent = node.parent;
+	node.parent = higherChildId;
+
+	if (higherChild.parent != NULL_PROXY) {
+		if (m_nodes[higherChild.parent].firstChild == nodeId)
+			m_nodes[higherChild.parent].firstChild = higherChildId;
+		else
+			m_nodes[higherChild.parent].secondChild = higherChildId;
+	}
+	else {
+		m_rootId = higherChildId;
+	}
+
+	higherChild.firstChild = nodeId;
+	higherChild.secondChild = tallerGrandChildId;
+
+	if (isSecondChildHigher)
+		node.secondChild = shorterGrandChildId;
+	else
+		node.firstChild = shorterGrandChildId;
+
+	m_nodes[shorterGrandChildId].parent = nodeId;
+
+	node.bounds = AABB::merge(m_nodes[lowerChildId].bounds, m_nodes[shorterGrandChildId].bounds);
+	node.height = 1 + std::max(m_nodes[lowerChildId].height, m_nodes[shorterGrandChildId].height);
+
+	higherChild.bounds = AABB::merge(node.bounds, m_nodes[tallerGrandChildId].bounds);
+	higherChild.height = 1 + std::max(node.height, m_nodes[tallerGrandChildId].height);
+
+	return higherChildId;
+}
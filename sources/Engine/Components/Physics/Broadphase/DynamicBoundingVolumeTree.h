@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Engine/types.h>
+#include <Engine/Components/Physics/Colliders/AABB.h>
+
+#include <vector>
+
+// Incremental bounding volume tree for moving objects. Leaves keep enlarged bounds,
+// so small movements don't need to touch the tree at all
+class DynamicBoundingVolumeTree {
+public:
+	using ProxyId = int32;
+
+	static const ProxyId NULL_PROXY = -1;
+
+public:
+	DynamicBoundingVolumeTree(float boundsMargin);
+	~DynamicBoundingVolumeTree();
+
+	ProxyId createProxy(const AABB& bounds, void* userData);
+	void destroyProxy(ProxyId proxyId);
+
+	// Returns true if the proxy was reinserted into the tree
+	bool moveProxy(ProxyId proxyId, const AABB& bounds);
+
+	void* getUserData(ProxyId proxyId) const;
+	const AABB& getFatBounds(ProxyId proxyId) const;
+
+	// Appends proxies whose enlarged bounds intersect the box
+	void query(const AABB& bounds, std::vector<ProxyId>& proxies) const;
+
+	size_t getProxiesCount() const;
+	size_t getHeight() const;
+
+private:
+	struct Node {
+		AABB bounds;
+		void* userData;
+
+		// Next free node for the nodes in the free list
+		ProxyId parent;
+
+		ProxyId firstChild;
+		ProxyId secondChild;
+
+		// Leaf height is zero, free node height is -1
+		int32 height;
+
+		bool isLeaf() const {
+			return firstChild == NULL_PROXY;
+		}
+	};
+
+private:
+	ProxyId allocateNode();
+	void freeNode(ProxyId nodeId);
+
+	void insertLeaf(ProxyId leafId);
+	void removeLeaf(ProxyId leafId);
+
+	// Walks up from the node refitting bounds and rebalancing the tree
+	void refitAncestors(ProxyId nodeId);
+	ProxyId balance(ProxyId nodeId);
+
+private:
+	std::vector<Node> m_nodes;
+
+	ProxyId m_rootId;
+	ProxyId m_freeListId;
+
+	size_t m_proxiesCount;
+
+	float m_boundsMargin;
+};
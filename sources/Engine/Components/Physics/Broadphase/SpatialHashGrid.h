@@ -0,0 +1,252 @@
+#pragma once
+
+#include <Engine\types.h>
+#include <Engine\assertions.h>
+#include <Engine\Components\Math\types.h>
+#include <Engine\Components\Memory\FrameAllocator.h>
+
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+
+// Uniform grid of point items hashed by the cell coordinates, so only the occupied cells are stored.
+// Queries visit the cells around the query point only, regardless of the total items count
+template<class T>
+class SpatialHashGrid {
+public:
+	SpatialHashGrid(float cellSize);
+	~SpatialHashGrid();
+
+	void insert(const T& item, const vector3& position);
+	void update(const T& item, const vector3& position);
+	void remove(const T& item);
+
+	bool contains(const T& item) const;
+	size_t getItemsCount() const;
+
+	// Items not farther than the radius, sorted by the distance
+	template<class Allocator>
+	void queryRadius(const vector3& center, float radius, std::vector<T, Allocator>& items) const;
+
+	// Items not farther than the radius and within the angle (in degrees) from the direction, sorted by the distance
+	template<class Allocator>
+	void queryCone(const vector3& apex, const vector3& direction, float radius, float angle, std::vector<T, Allocator>& items) const;
+
+private:
+	using CellKey = uint64;
+
+	// Positions are kept in the cells, so the queries read them without lookups
+	struct CellItem {
+		T item;
+		vector3 position;
+	};
+
+private:
+	ivector3 getCell(const vector3& position) const;
+	static CellKey getCellKey(const ivector3& cell);
+
+	void addToCell(const T& item, const vector3& position, CellKey cellKey);
+	void removeFromCell(const T& item, CellKey cellKey);
+
+	CellItem& findCellItem(const T& item, CellKey cellKey);
+
+	// Appends the items within the radius and the cone with their squared distances,
+	// the cone with the angle cosine -1 includes everything
+	void collectItems(const vector3& center, float radius, FrameVector<std::pair<float, T>>& items,
+		const vector3& coneDirection, float coneAngleCosine) const;
+
+	template<class Allocator>
+	static void sortItems(FrameVector<std::pair<float, T>>& sortedItems, std::vector<T, Allocator>& items);
+
+private:
+	float m_cellSize;
+
+	std::unordered_map<CellKey, std::vector<CellItem>> m_cells;
+	std::unordered_map<T, CellKey> m_itemsCells;
+};
+
+template<class T>
+inline SpatialHashGrid<T>::SpatialHashGrid(float cellSize)
+	: m_cellSize(cellSize)
+{
+	_assert(cellSize > 0.0f);
+}
+
+template<class T>
+inline SpatialHashGrid<T>::~SpatialHashGrid()
+{
+}
+
+template<class T>
+inline void SpatialHashGrid<T>::insert(const T & item, const vector3 & position)
+{
+	_assert(!contains(item));
+
+	CellKey cellKey = getCellKey(getCell(position));
+
+	m_itemsCells[item] = cellKey;
+	addToCell(item, position, cellKey);
+}
+
+template<class T>
+inline void SpatialHashGrid<T>::update(const T & item, const vector3 & position)
+{
+	auto itemIt = m_itemsCells.find(item);
+	_assert(itemIt != m_itemsCells.end());
+
+	CellKey cellKey = getCellKey(getCell(position));
+
+	if (itemIt->second == cellKey) {
+		findCellItem(item, cellKey).position = position;
+		return;
+	}
+
+	removeFromCell(item, itemIt->second);
+	addToCell(item, position, cellKey);
+
+	itemIt->second = cellKey;
+}
+
+template<class T>
+inline void SpatialHashGrid<T>::remove(const T & item)
+{
+	auto itemIt = m_itemsCells.find(item);
+	_assert(itemIt != m_itemsCells.end());
+
+	removeFromCell(item, itemIt->second);
+	m_itemsCells.erase(itemIt);
+}
+
+template<class T>
+inline bool SpatialHashGrid<T>::contains(const T & item) const
+{
+	return m_itemsCells.find(item) != m_itemsCells.end();
+}
+
+template<class T>
+inline size_t SpatialHashGrid<T>::getItemsCount() const
+{
+	return m_itemsCells.size();
+}
+
+template<class T>
+template<class Allocator>
+inline void SpatialHashGrid<T>::queryRadius(const vector3 & center, float radius, std::vector<T, Allocator>& items) const
+{
+	FrameVector<std::pair<float, T>> sortedItems;
+	collectItems(center, radius, sortedItems, vector3(0.0f), -1.0f);
+
+	sortItems(sortedItems, items);
+}
+
+template<class T>
+template<class Allocator>
+inline void SpatialHashGrid<T>::queryCone(const vector3 & apex, const vector3 & direction, float radius, float angle, 
+	std::vector<T, Allocator>& items) const
+{
+	FrameVector<std::pair<float, T>> sortedItems;
+	collectItems(apex, radius, sortedItems, glm::normalize(direction), std::cos(glm::radians(angle)));
+
+	sortItems(sortedItems, items);
+}
+
+template<class T>
+inline ivector3 SpatialHashGrid<T>::getCell(const vector3 & position) const
+{
+	return ivector3(glm::floor(position / m_cellSize));
+}
+
+template<class T>
+inline typename SpatialHashGrid<T>::CellKey SpatialHashGrid<T>::getCellKey(const ivector3 & cell)
+{
+	// 21 bits per coordinate, the grid wraps around far beyond any level size
+	const uint64 COORDINATE_MASK = (1 << 21) - 1;
+
+	return ((uint64)(cell.x & COORDINATE_MASK) << 42) | ((uint64)(cell.y & COORDINATE_MASK) << 21) | (uint64)(cell.z & COORDINATE_MASK);
+}
+
+template<class T>
+inline void SpatialHashGrid<T>::addToCell(const T & item, const vector3 & position, CellKey cellKey)
+{
+	m_cells[cellKey].push_back({ item, position });
+}
+
+template<class T>
+inline void SpatialHashGrid<T>::removeFromCell(const T & item, CellKey cellKey)
+{
+	auto cellIt = m_cells.find(cellKey);
+	_assert(cellIt != m_cells.end());
+
+	std::vector<CellItem>& cellItems = cellIt->second;
+
+	CellItem& cellItem = findCellItem(item, cellKey);
+	cellItem = cellItems.back();
+	cellItems.pop_back();
+
+	if (cellItems.empty())
+		m_cells.erase(cellIt);
+}
+
+template<class T>
+inline typename SpatialHashGrid<T>::CellItem & SpatialHashGrid<T>::findCellItem(const T & item, CellKey cellKey)
+{
+	std::vector<CellItem>& cellItems = m_cells.at(cellKey);
+
+	auto itemIt = std::find_if(cellItems.begin(), cellItems.end(), [&item](const CellItem& cellItem) {
+		return cellItem.item == item;
+	});
+
+	_assert(itemIt != cellItems.end());
+
+	return *itemIt;
+}
+
+template<class T>
+inline void SpatialHashGrid<T>::collectItems(const vector3 & center, float radius, FrameVector<std::pair<float, T>>& items,
+	const vector3& coneDirection, float coneAngleCosine) const
+{
+	ivector3 minCell = getCell(center - vector3(radius));
+	ivector3 maxCell = getCell(center + vector3(radius));
+
+	float radiusSquared = radius * radius;
+
+	for (int x = minCell.x; x <= maxCell.x; x++) {
+		for (int y = minCell.y; y <= maxCell.y; y++) {
+			for (int z = minCell.z; z <= maxCell.z; z++) {
+				auto cellIt = m_cells.find(getCellKey(ivector3(x, y, z)));
+
+				if (cellIt == m_cells.end())
+					continue;
+
+				for (const CellItem& cellItem : cellIt->second) {
+					vector3 delta = cellItem.position - center;
+					float distanceSquared = glm::dot(delta, delta);
+
+					if (distanceSquared > radiusSquared)
+						continue;
+
+					// Items at the apex are inside of any cone
+					if (distanceSquared > 1e-12f && glm::dot(delta, coneDirection) < coneAngleCosine * std::sqrt(distanceSquared))
+						continue;
+
+					items.push_back({ distanceSquared, cellItem.item });
+				}
+			}
+		}
+	}
+}
+
+template<class T>
+template<class Allocator>
+inline void SpatialHashGrid<T>::sortItems(FrameVector<std::pair<float, T>>& sortedItems, std::vector<T, Allocator>& items)
+{
+	std::sort(sortedItems.begin(), sortedItems.end(), [](const std::pair<float, T>& first, const std::pair<float, T>& second) {
+		return first.first < second.first;
+	});
+
+	items.clear();
+	items.reserve(sortedItems.size());
+
+	for (const std::pair<float, T>& item : sortedItems)
+		items.push_back(item.second);
+}
@@ -1,6 +1,11 @@
 #include "AABB.h"
+#include "Sphere.h"
+#include "OBB.h"
+#include "Capsule.h"
 
 #include <utility>
+#include <algorithm>
+#include <limits>
 
 AABB::AABB()
 	: m_min(vector3()), m_max(vector3())
@@ -23,7 +28,7 @@ void AABB::setMin(const vector3 & min)
 
 vector3 AABB::getMin() const
 {
-	return m_max;
+	return m_min;
 }
 
 void AABB::setMax(const vector3 & max)
@@ -36,6 +41,146 @@ vector3 AABB::getMax() const
 	return m_max;
 }
 
+vector3 AABB::getCenter() const
+{
+	return 0.5f * (m_min + m_max);
+}
+
+vector3 AABB::getSize() const
+{
+	return m_max - m_min;
+}
+
+float AABB::getSurfaceArea() const
+{
+	vector3 size = m_max - m_min;
+
+	return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+void AABB::merge(const AABB & box)
+{
+	m_min = glm::min(m_min, box.m_min);
+	m_max = glm::max(m_max, box.m_max);
+}
+
+void AABB::expand(float margin)
+{
+	m_min -= vector3(margin);
+	m_max += vector3(margin);
+}
+
+AABB AABB::getSwept(const vector3 & displacement) const
+{
+	return AABB(m_min + glm::min(displacement, vector3(0.0f)), m_max + glm::max(displacement, vector3(0.0f)));
+}
+
+bool AABB::contains(const AABB & box) const
+{
+	return m_min.x <= box.m_min.x && m_min.y <= box.m_min.y && m_min.z <= box.m_min.z &&
+		box.m_max.x <= m_max.x && box.m_max.y <= m_max.y && box.m_max.z <= m_max.z;
+}
+
+bool AABB::intersects(const AABB & box) const
+{
+	return m_min.x <= box.m_max.x && box.m_min.x <= m_max.x &&
+		m_min.y <= box.m_max.y && box.m_min.y <= m_max.y &&
+		m_min.z <= box.m_max.z && box.m_min.z <= m_max.z;
+}
+
+bool AABB::intersects(const AABB & box, Intersection & intersection) const
+{
+	// Distances to move the boxes apart along the direction between the centers, they are larger than
+	// the overlap lengths when one box contains the other one along the axis
+	vector3 overlaps = 0.5f * (getSize() + box.getSize()) - glm::abs(getCenter() - box.getCenter());
+
+	if (overlaps.x < 0.0f || overlaps.y < 0.0f || overlaps.z < 0.0f)
+		return false;
+
+	size_t minOverlapAxis = 0;
+
+	for (size_t axis = 1; axis < 3; axis++) {
+		if (overlaps[axis] < overlaps[minOverlapAxis])
+			minOverlapAxis = axis;
+	}
+
+	vector3 direction(0.0f);
+	direction[minOverlapAxis] = (getCenter()[minOverlapAxis] < box.getCenter()[minOverlapAxis]) ? -1.0f : 1.0f;
+
+	intersection.setDirection(direction);
+	intersection.setDepth(overlaps[minOverlapAxis]);
+	intersection.setFeatureId(minOverlapAxis);
+
+	return true;
+}
+
+bool AABB::intersects(const Sphere & sphere, Intersection & intersection) const
+{
+	if (!sphere.intersects(*this, intersection))
+		return false;
+
+	intersection.setDirection(-intersection.getDirection());
+
+	return true;
+}
+
+bool AABB::intersects(const OBB & box, Intersection & intersection) const
+{
+	// Bounds are compared before building the box for the separating axis test
+	if (!intersects(box.getBoundingBox()))
+		return false;
+
+	return OBB(*this).intersects(box, intersection);
+}
+
+bool AABB::intersects(const Capsule & capsule, Intersection & intersection) const
+{
+	if (!intersects(capsule.getBoundingBox()))
+		return false;
+
+	return OBB(*this).intersects(capsule, intersection);
+}
+
+Sphere AABB::getBoundingSphere() const
+{
+	return Sphere(getCenter(), 0.5f * glm::length(m_max - m_min));
+}
+
+bool AABB::intersects(const Ray & ray, float & distance) const
+{
+	vector3 rayOrigin = ray.getOrigin();
+	vector3 rayDirection = ray.getDirection();
+
+	float tNear = -std::numeric_limits<float>::infinity();
+	float tFar = std::numeric_limits<float>::infinity();
+
+	for (int axis = 0; axis < 3; axis++) {
+		// Division by zero gives infinities, which are handled by the slabs comparison
+		float inverseDirection = 1.0f / rayDirection[axis];
+
+		float t0 = (m_min[axis] - rayOrigin[axis]) * inverseDirection;
+		float t1 = (m_max[axis] - rayOrigin[axis]) * inverseDirection;
+
+		if (t0 > t1)
+			std::swap(t0, t1);
+
+		tNear = std::max(tNear, t0);
+		tFar = std::min(tFar, t1);
+
+		if (tNear > tFar || tFar < 0.0f)
+			return false;
+	}
+
+	distance = tNear > 0.0f ? tNear : tFar;
+
+	return true;
+}
+
+AABB AABB::merge(const AABB & first, const AABB & second)
+{
+	return AABB(glm::min(first.m_min, second.m_min), glm::max(first.m_max, second.m_max));
+}
+
 bool AABB::isRayIntersecting(const Ray & ray)
 {
 	vector3 rayOrigin = ray.getOrigin();
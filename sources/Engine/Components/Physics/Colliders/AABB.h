@@ -1,7 +1,12 @@
 #pragma once
 
-#include <Engine\Components\Math\types.h>
-#include <Engine\Components\Physics\Ray.h>
+#include <Engine/Components/Math/types.h>
+#include <Engine/Components/Physics/Ray.h>
+#include <Engine/Components/Physics/Intersection.h>
+
+class Sphere;
+class OBB;
+class Capsule;
 
 class AABB {
 public:
@@ -15,7 +20,34 @@ public:
 	void setMax(const vector3& max);
 	vector3 getMax() const;
 
+	vector3 getCenter() const;
+	vector3 getSize() const;
+
+	float getSurfaceArea() const;
+
+	// Grows the box to enclose the given one
+	void merge(const AABB& box);
+	void expand(float margin);
+
+	// Box enclosing all the positions of this box moved along the displacement
+	AABB getSwept(const vector3& displacement) const;
+
+	bool contains(const AABB& box) const;
+	bool intersects(const AABB& box) const;
+
+	// Directions of the intersections push this box out of the second collider
+	bool intersects(const AABB& box, Intersection& intersection) const;
+	bool intersects(const Sphere& sphere, Intersection& intersection) const;
+	bool intersects(const OBB& box, Intersection& intersection) const;
+	bool intersects(const Capsule& capsule, Intersection& intersection) const;
+
+	Sphere getBoundingSphere() const;
+
 	bool isRayIntersecting(const Ray& ray);
+	bool intersects(const Ray& ray, float& distance) const;
+
+public:
+	static AABB merge(const AABB& first, const AABB& second);
 
 protected:
 	vector3 m_min;
@@ -0,0 +1,159 @@
+#include "Capsule.h"
+#include "OBB.h"
+
+#include <algorithm>
+
+Capsule::Capsule()
+	: m_start(), m_end(), m_radius(0.0f)
+{
+}
+
+Capsule::Capsule(const vector3 & start, const vector3 & end, float radius)
+	: m_start(start), m_end(end), m_radius(radius)
+{
+}
+
+Capsule::~Capsule()
+{
+}
+
+vector3 Capsule::getStart() const
+{
+	return m_start;
+}
+
+void Capsule::setStart(const vector3 & start)
+{
+	m_start = start;
+}
+
+vector3 Capsule::getEnd() const
+{
+	return m_end;
+}
+
+void Capsule::setEnd(const vector3 & end)
+{
+	m_end = end;
+}
+
+float Capsule::getRadius() const
+{
+	return m_radius;
+}
+
+void Capsule::setRadius(float radius)
+{
+	m_radius = radius;
+}
+
+vector3 Capsule::getClosestPoint(const vector3 & point) const
+{
+	vector3 segment = m_end - m_start;
+	float segmentLengthSquared = glm::dot(segment, segment);
+
+	if (segmentLengthSquared <= 1e-12f)
+		return m_start;
+
+	float t = glm::clamp(glm::dot(point - m_start, segment) / segmentLengthSquared, 0.0f, 1.0f);
+
+	return m_start + segment * t;
+}
+
+bool Capsule::intersects(const AABB & box, Intersection & intersection) const
+{
+	if (!box.intersects(getBoundingBox()))
+		return false;
+
+	return intersects(OBB(box), intersection);
+}
+
+bool Capsule::intersects(const Sphere & sphere, Intersection & intersection) const
+{
+	return Sphere(getClosestPoint(sphere.getCenter()), m_radius).intersects(sphere, intersection);
+}
+
+bool Capsule::intersects(const OBB & box, Intersection & intersection) const
+{
+	if (!box.intersects(*this, intersection))
+		return false;
+
+	intersection.setDirection(-intersection.getDirection());
+
+	return true;
+}
+
+bool Capsule::intersects(const Capsule & second, Intersection & intersection) const
+{
+	vector3 point;
+	vector3 secondPoint;
+
+	findClosestPoints(second, point, secondPoint);
+
+	return Sphere(point, m_radius).intersects(Sphere(secondPoint, second.m_radius), intersection);
+}
+
+AABB Capsule::getBoundingBox() const
+{
+	vector3 radius(m_radius);
+
+	return AABB(glm::min(m_start, m_end) - radius, glm::max(m_start, m_end) + radius);
+}
+
+Sphere Capsule::getBoundingSphere() const
+{
+	return Sphere(0.5f * (m_start + m_end), 0.5f * glm::distance(m_start, m_end) + m_radius);
+}
+
+void Capsule::findClosestPoints(const Capsule & second, vector3 & point, vector3 & secondPoint) const
+{
+	const float eps = 1e-12f;
+
+	vector3 direction = m_end - m_start;
+	vector3 secondDirection = second.m_end - second.m_start;
+	vector3 startsDelta = m_start - second.m_start;
+
+	float lengthSquared = glm::dot(direction, direction);
+	float secondLengthSquared = glm::dot(secondDirection, secondDirection);
+	float secondProjection = glm::dot(secondDirection, startsDelta);
+
+	// Parameters of the closest points along the segments
+	float s = 0.0f;
+	float t = 0.0f;
+
+	if (lengthSquared <= eps && secondLengthSquared <= eps) {
+		// Both segments are points
+	}
+	else if (lengthSquared <= eps) {
+		t = glm::clamp(secondProjection / secondLengthSquared, 0.0f, 1.0f);
+	}
+	else {
+		float projection = glm::dot(direction, startsDelta);
+
+		if (secondLengthSquared <= eps) {
+			s = glm::clamp(-projection / lengthSquared, 0.0f, 1.0f);
+		}
+		else {
+			float directionsDot = glm::dot(direction, secondDirection);
+			float denominator = lengthSquared * secondLengthSquared - directionsDot * directionsDot;
+
+			// Parallel segments have no single closest pair, any point of the first one fits
+			if (denominator > eps)
+				s = glm::clamp((directionsDot * secondProjection - projection * secondLengthSquared) / denominator, 0.0f, 1.0f);
+
+			t = (directionsDot * s + secondProjection) / secondLengthSquared;
+
+			if (t < 0.0f) {
+				t = 0.0f;
+				s = glm::clamp(-projection / lengthSquared, 0.0f, 1.0f);
+			}
+			else if (t > 1.0f) {
+				t = 1.0f;
+				s = glm::clamp((directionsDot - projection) / lengthSquared, 0.0f, 1.0f);
+			}
+		}
+	}
+
+	point = m_start + direction * s;
+	secondPoint = second.m_start + secondDirection * t;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <Engine/Components/Math/types.h>
+#include <Engine/Components/Physics/Intersection.h>
+#include <Engine/Components/Physics/Colliders/AABB.h>
+#include <Engine/Components/Physics/Colliders/Sphere.h>
+
+class OBB;
+
+// Segment swept by a sphere
+class Capsule {
+public:
+	Capsule();
+	Capsule(const vector3& start, const vector3& end, float radius);
+	~Capsule();
+
+	vector3 getStart() const;
+	void setStart(const vector3& start);
+
+	vector3 getEnd() const;
+	void setEnd(const vector3& end);
+
+	float getRadius() const;
+	void setRadius(float radius);
+
+	// Closest point of the inner segment
+	vector3 getClosestPoint(const vector3& point) const;
+
+	// Directions of the intersections push this capsule out of the second collider
+	bool intersects(const AABB& box, Intersection& intersection) const;
+	bool intersects(const Sphere& sphere, Intersection& intersection) const;
+	bool intersects(const OBB& box, Intersection& intersection) const;
+	bool intersects(const Capsule& second, Intersection& intersection) const;
+
+	AABB getBoundingBox() const;
+	Sphere getBoundingSphere() const;
+
+private:
+	// Closest points of the inner segments of two capsules
+	void findClosestPoints(const Capsule& second, vector3& point, vector3& secondPoint) const;
+
+private:
+	vector3 m_start;
+	vector3 m_end;
+	float m_radius;
+};
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <Engine/types.h>
+#include <Engine/Components/Physics/Intersection.h>
+#include <Engine/Components/Physics/Colliders/AABB.h>
+#include <Engine/Components/Physics/Colliders/Sphere.h>
+#include <Engine/Components/Physics/Colliders/OBB.h>
+#include <Engine/Components/Physics/Colliders/Capsule.h>
+
+#include <vector>
+#include <algorithm>
+
+struct BatchIntersection {
+	// Index of the collider in the batch
+	size_t colliderIndex;
+
+	// Pushes the tested collider out of the batch one
+	Intersection intersection;
+};
+
+// Colliders prepared for testing one collider against all of them (AABB, Sphere, OBB or Capsule).
+// Bounding boxes are kept in the structure of arrays layout, so the pre-test is a plain loop over
+// the float arrays, and only the colliders passing it get the exact test
+template<class Collider>
+class CollidersBatch {
+public:
+	CollidersBatch();
+	~CollidersBatch();
+
+	void add(const Collider& collider);
+	void clear();
+
+	size_t getSize() const;
+	const Collider& getCollider(size_t colliderIndex) const;
+
+	// Appends indices of the colliders whose bounding boxes intersect the box
+	void findCandidates(const AABB& bounds, std::vector<uint32>& candidates) const;
+
+	// Appends the colliders intersecting the tested one, returns the number of the found intersections
+	template<class TestedCollider>
+	size_t intersect(const TestedCollider& collider, std::vector<BatchIntersection>& intersections) const;
+
+private:
+	// Writes whether the bounding boxes of the colliders [begin, begin + count) intersect the box
+	void testBounds(const AABB& bounds, size_t begin, size_t count, uint32* overlaps) const;
+
+	static AABB getBounds(const AABB& box);
+
+	template<class AnyCollider>
+	static AABB getBounds(const AnyCollider& collider);
+
+private:
+	// Pre-test results are gathered in chunks on the stack
+	static const size_t PRETEST_CHUNK_SIZE = 64;
+
+private:
+	std::vector<Collider> m_colliders;
+
+	std::vector<float> m_minX;
+	std::vector<float> m_minY;
+	std::vector<float> m_minZ;
+
+	std::vector<float> m_maxX;
+	std::vector<float> m_maxY;
+	std::vector<float> m_maxZ;
+};
+
+template<class Collider>
+inline CollidersBatch<Collider>::CollidersBatch()
+{
+}
+
+template<class Collider>
+inline CollidersBatch<Collider>::~CollidersBatch()
+{
+}
+
+template<class Collider>
+inline void CollidersBatch<Collider>::add(const Collider & collider)
+{
+	AABB bounds = getBounds(collider);
+	vector3 min = bounds.getMin();
+	vector3 max = bounds.getMax();
+
+	m_colliders.push_back(collider);
+
+	m_minX.push_back(min.x);
+	m_minY.push_back(min.y);
+	m_minZ.push_back(min.z);
+
+	m_maxX.push_back(max.x);
+	m_maxY.push_back(max.y);
+	m_maxZ.push_back(max.z);
+}
+
+template<class Collider>
+inline void CollidersBatch<Collider>::clear()
+{
+	m_colliders.clear();
+
+	m_minX.clear();
+	m_minY.clear();
+	m_minZ.clear();
+
+	m_maxX.clear();
+	m_maxY.clear();
+	m_maxZ.clear();
+}
+
+template<class Collider>
+inline size_t CollidersBatch<Collider>::getSize() const
+{
+	return m_colliders.size();
+}
+
+template<class Collider>
+inline const Collider & CollidersBatch<Collider>::getCollider(size_t colliderIndex) const
+{
+	return m_colliders[colliderIndex];
+}
+
+template<class Collider>
+inline void CollidersBatch<Collider>::findCandidates(const AABB & bounds, std::vector<uint32>& candidates) const
+{
+	size_t collidersCount = m_colliders.size();
+
+	for (size_t chunkBegin = 0; chunkBegin < collidersCount; chunkBegin += PRETEST_CHUNK_SIZE) {
+		size_t chunkSize = std::min(PRETEST_CHUNK_SIZE, collidersCount - chunkBegin);
+
+		uint32 overlaps[PRETEST_CHUNK_SIZE];
+		testBounds(bounds, chunkBegin, chunkSize, overlaps);
+
+		for (size_t index = 0; index < chunkSize; index++) {
+			if (overlaps[index])
+				candidates.push_back(static_cast<uint32>(chunkBegin + index));
+		}
+	}
+}
+
+template<class Collider>
+template<class TestedCollider>
+inline size_t CollidersBatch<Collider>::intersect(const TestedCollider & collider,
+	std::vector<BatchIntersection>& intersections) const
+{
+	AABB bounds = getBounds(collider);
+
+	size_t collidersCount = m_colliders.size();
+	size_t intersectionsCount = 0;
+
+	for (size_t chunkBegin = 0; chunkBegin < collidersCount; chunkBegin += PRETEST_CHUNK_SIZE) {
+		size_t chunkSize = std::min(PRETEST_CHUNK_SIZE, collidersCount - chunkBegin);
+
+		uint32 overlaps[PRETEST_CHUNK_SIZE];
+		testBounds(bounds, chunkBegin, chunkSize, overlaps);
+
+		for (size_t index = 0; index < chunkSize; index++) {
+			if (!overlaps[index])
+				continue;
+
+			Intersection intersection;
+
+			if (collider.intersects(m_colliders[chunkBegin + index], intersection)) {
+				intersections.push_back({ chunkBegin + index, intersection });
+				intersectionsCount++;
+			}
+		}
+	}
+
+	return intersectionsCount;
+}
+
+template<class Collider>
+inline void CollidersBatch<Collider>::testBounds(const AABB & bounds, size_t begin, size_t count, uint32 * overlaps) const
+{
+	vector3 min = bounds.getMin();
+	vector3 max = bounds.getMax();
+
+	const float* minX = &m_minX[begin];
+	const float* minY = &m_minY[begin];
+	const float* minZ = &m_minZ[begin];
+
+	const float* maxX = &m_maxX[begin];
+	const float* maxY = &m_maxY[begin];
+	const float* maxZ = &m_maxZ[begin];
+
+	// Branchless, so the compiler vectorizes the loop
+	for (size_t index = 0; index < count; index++) {
+		overlaps[index] = (minX[index] <= max.x) & (min.x <= maxX[index]) &
+			(minY[index] <= max.y) & (min.y <= maxY[index]) &
+			(minZ[index] <= max.z) & (min.z <= maxZ[index]);
+	}
+}
+
+template<class Collider>
+inline AABB CollidersBatch<Collider>::getBounds(const AABB & box)
+{
+	return box;
+}
+
+template<class Collider>
+template<class AnyCollider>
+inline AABB CollidersBatch<Collider>::getBounds(const AnyCollider & collider)
+{
+	return collider.getBoundingBox();
+}
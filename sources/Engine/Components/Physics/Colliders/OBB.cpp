@@ -1,7 +1,18 @@
 #include "OBB.h"
 
+#include <Engine/assertions.h>
+
 #include <vector>
 #include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1) || defined(__SSE__)
+#define OBB_SSE_ENABLED
+#include <xmmintrin.h>
+#endif
+
+// Boxes overlapping less than this at the start of the sweep are only touching, as the resolved contacts leave them
+static const float SWEEP_INITIAL_OVERLAP_TOLERANCE = 1e-4f;
 
 OBB::OBB(const OBB & obb, const matrix4& transform)
 	: m_origin(transform * vector4(obb.m_origin, 1.0f)),
@@ -18,6 +29,15 @@ OBB::OBB(const vector3 & origin, const vector3 & v1, const vector3 & v2, const v
 	calculateProperties();
 }
 
+OBB::OBB(const AABB & box)
+	: m_origin(box.getMin()), 
+	m_vertex1(box.getMin() + vector3(box.getSize().x, 0.0f, 0.0f)),
+	m_vertex2(box.getMin() + vector3(0.0f, box.getSize().y, 0.0f)),
+	m_vertex3(box.getMin() + vector3(0.0f, 0.0f, box.getSize().z))
+{
+	calculateProperties();
+}
+
 OBB::~OBB()
 {
 }
@@ -40,50 +60,63 @@ void OBB::calculateProperties()
 	m_size.x = glm::length(bx);
 	m_size.y = glm::length(by);
 	m_size.z = glm::length(bz);
+
+	m_normals[0] = glm::normalize(glm::cross(m_basis[0], m_basis[1]));
+	m_normals[1] = glm::normalize(glm::cross(m_basis[0], m_basis[2]));
+	m_normals[2] = glm::normalize(glm::cross(m_basis[1], m_basis[2]));
+
+	m_halfAxes[0] = 0.5f * bx;
+	m_halfAxes[1] = 0.5f * by;
+	m_halfAxes[2] = 0.5f * bz;
+
+	m_boundingRadius = 0.5f * (m_size.x + m_size.y + m_size.z);
 }
 
 bool OBB::intersects(const OBB& second, Intersection& intersection) const
 {
-	std::vector<vector3> normalsFirst = this->getNormals();
-	std::vector<vector3> normalsSecond = second.getNormals();
+	vector3 centersDelta = m_center - second.m_center;
+	float boundingRadiusesSum = m_boundingRadius + second.m_boundingRadius;
 
-	//    
-	std::vector<vector3> checkedDirections;
+	// Bounding spheres reject most of the far pairs cheaper than any axis
+	if (glm::dot(centersDelta, centersDelta) > boundingRadiusesSum * boundingRadiusesSum)
+		return false;
 
-	checkedDirections.insert(checkedDirections.end(), normalsFirst.begin(), normalsFirst.end());
-	checkedDirections.insert(checkedDirections.end(), normalsSecond.begin(), normalsSecond.end());
+	vector3 axes[MAX_SEPARATING_AXES_COUNT];
+	size_t featuresIds[MAX_SEPARATING_AXES_COUNT];
 
-	for (int i = 0; i < 3; i++)
-		for (int j = 0; j < 3; j++) {
-			if (normalsFirst[i] == normalsSecond[j])
-				continue;
+	size_t axesCount = collectSeparatingAxes(second, axes, featuresIds);
 
-			checkedDirections.push_back(glm::normalize(glm::cross(normalsFirst[i], normalsSecond[j])));
-		}
+	// Unused axes of the last batch just repeat the first one
+	for (size_t axisIndex = axesCount; axisIndex < MAX_SEPARATING_AXES_COUNT; axisIndex++)
+		axes[axisIndex] = axes[0];
 
 	vector3 mtv;
 	float mtvLength = std::numeric_limits<float>::infinity();
+	size_t mtvFeatureId = 0;
 
-	//   OBB  
-	for (const vector3& direction : checkedDirections) {
-		ProjectionBounds firstProjection = this->getProjection(direction);
-		ProjectionBounds secondProjection = second.getProjection(direction);
+	for (size_t batchBegin = 0; batchBegin < axesCount; batchBegin += SEPARATING_AXES_BATCH_SIZE) {
+		float overlaps[SEPARATING_AXES_BATCH_SIZE];
+		calculateOverlaps(second, &axes[batchBegin], overlaps);
 
-		float intersectionLength = ProjectionBounds::getOverlapLength(firstProjection, secondProjection);
+		size_t batchSize = std::min(SEPARATING_AXES_BATCH_SIZE, axesCount - batchBegin);
 
-		if (abs(intersectionLength) <= 1e-6f)
-			return false;
+		for (size_t axisIndex = 0; axisIndex < batchSize; axisIndex++) {
+			if (overlaps[axisIndex] <= 1e-6f)
+				return false;
 
-		if (abs(intersectionLength) < abs(mtvLength)) {
-			mtv = direction;
-			mtvLength = intersectionLength;
+			if (overlaps[axisIndex] < mtvLength) {
+				mtv = axes[batchBegin + axisIndex];
+				mtvLength = overlaps[axisIndex];
+				mtvFeatureId = featuresIds[batchBegin + axisIndex];
+			}
 		}
 	}
 
 	intersection.setDirection(mtv);
 	intersection.setDepth(mtvLength);
+	intersection.setFeatureId(mtvFeatureId);
 
-	bool notPointingInTheSameDirection = glm::dot(getCenter() - second.getCenter(), mtv) < 0;
+	bool notPointingInTheSameDirection = glm::dot(centersDelta, mtv) < 0;
 
 	if (notPointingInTheSameDirection) {
 		intersection.setDirection(-mtv);
@@ -92,26 +125,314 @@ bool OBB::intersects(const OBB& second, Intersection& intersection) const
 	return true;
 }
 
-std::vector<vector3> OBB::getNormals() const {
-	return std::vector<vector3>{
-		glm::normalize(glm::cross(m_basis[0], m_basis[1])), 
-			glm::normalize(glm::cross(m_basis[0], m_basis[2])), 
-			glm::normalize(glm::cross(m_basis[1], m_basis[2]))
+bool OBB::intersects(const AABB & box, Intersection & intersection) const
+{
+	if (!box.intersects(getBoundingBox()))
+		return false;
+
+	return intersects(OBB(box), intersection);
+}
+
+bool OBB::intersects(const Sphere & sphere, Intersection & intersection) const
+{
+	if (!intersectsSphere(sphere.getCenter(), sphere.getRadius(), intersection))
+		return false;
+
+	intersection.setDirection(-intersection.getDirection());
+
+	return true;
+}
+
+bool OBB::intersects(const Capsule & capsule, Intersection & intersection) const
+{
+	vector3 start = capsule.getStart();
+	vector3 segment = capsule.getEnd() - start;
+
+	Sphere capsuleBounds = capsule.getBoundingSphere();
+	float boundingRadiusesSum = m_boundingRadius + capsuleBounds.getRadius();
+
+	vector3 centersDelta = m_center - capsuleBounds.getCenter();
+
+	if (glm::dot(centersDelta, centersDelta) > boundingRadiusesSum * boundingRadiusesSum)
+		return false;
+
+	// Signed distance to the box is convex along the segment, so the golden section search
+	// finds the point that is the closest to the box
+	const float inverseGoldenRatio = 0.618034f;
+
+	float lowerBound = 0.0f;
+	float upperBound = 1.0f;
+
+	float lowerProbe = upperBound - inverseGoldenRatio * (upperBound - lowerBound);
+	float upperProbe = lowerBound + inverseGoldenRatio * (upperBound - lowerBound);
+
+	float lowerProbeDistance = getSignedDistance(start + segment * lowerProbe);
+	float upperProbeDistance = getSignedDistance(start + segment * upperProbe);
+
+	for (size_t iteration = 0; iteration < CAPSULE_SEARCH_ITERATIONS_COUNT; iteration++) {
+		if (lowerProbeDistance < upperProbeDistance) {
+			upperBound = upperProbe;
+			upperProbe = lowerProbe;
+			upperProbeDistance = lowerProbeDistance;
+
+			lowerProbe = upperBound - inverseGoldenRatio * (upperBound - lowerBound);
+			lowerProbeDistance = getSignedDistance(start + segment * lowerProbe);
+		}
+		else {
+			lowerBound = lowerProbe;
+			lowerProbe = upperProbe;
+			lowerProbeDistance = upperProbeDistance;
+
+			upperProbe = lowerBound + inverseGoldenRatio * (upperBound - lowerBound);
+			upperProbeDistance = getSignedDistance(start + segment * upperProbe);
+		}
+	}
+
+	vector3 closestPoint = start + segment * (0.5f * (lowerBound + upperBound));
+
+	// Outside of the box the direction between the closest points is the shortest way out
+	if (getSignedDistance(closestPoint) > 0.0f)
+		return intersects(Sphere(closestPoint, capsule.getRadius()), intersection);
+
+	// The segment crosses the box, so it is pushed out along one of the axes of the segment and box separation
+	vector3 axes[6] = { m_basis[0], m_basis[1], m_basis[2] };
+	size_t axesCount = 3;
+
+	for (size_t basisIndex = 0; basisIndex < 3; basisIndex++) {
+		vector3 axis = glm::cross(segment, m_basis[basisIndex]);
+		float axisLengthSquared = glm::dot(axis, axis);
+
+		if (axisLengthSquared > 1e-10f)
+			axes[axesCount++] = axis / std::sqrt(axisLengthSquared);
+	}
+
+	vector3 capsuleCenter = start + 0.5f * segment;
+
+	vector3 mtv;
+	float mtvLength = std::numeric_limits<float>::infinity();
+
+	for (size_t axisIndex = 0; axisIndex < axesCount; axisIndex++) {
+		const vector3& axis = axes[axisIndex];
+
+		float capsuleRadius = 0.5f * std::abs(glm::dot(segment, axis)) + capsule.getRadius();
+		float boxRadius = std::abs(glm::dot(m_halfAxes[0], axis)) + std::abs(glm::dot(m_halfAxes[1], axis)) + 
+			std::abs(glm::dot(m_halfAxes[2], axis));
+
+		float overlap = capsuleRadius + boxRadius - std::abs(glm::dot(m_center - capsuleCenter, axis));
+
+		if (overlap < mtvLength) {
+			mtv = axis;
+			mtvLength = overlap;
+		}
+	}
+
+	intersection.setDirection(glm::dot(m_center - capsuleCenter, mtv) < 0.0f ? -mtv : mtv);
+	intersection.setDepth(mtvLength);
+	intersection.setFeatureId(0);
+
+	return true;
+}
+
+bool OBB::isSeparatedBy(const OBB & second, size_t featureId) const
+{
+	vector3 axis;
+
+	if (!getSeparatingAxis(second, featureId, axis))
+		return false;
+
+	ProjectionBounds projection = getProjection(axis);
+	ProjectionBounds secondProjection = second.getProjection(axis);
+
+	float overlap = std::min(projection.max, secondProjection.max) - std::max(projection.min, secondProjection.min);
+
+	return overlap <= 1e-6f;
+}
+
+bool OBB::sweep(const vector3 & displacement, const OBB & obstacle, float & timeOfImpact, vector3 & normal) const
+{
+	float boundingRadiusesSum = m_boundingRadius + obstacle.m_boundingRadius;
+
+	// Bounding sphere of the obstacle should be touched by the path of the bounding sphere of the box
+	vector3 centersDelta = obstacle.m_center - m_center;
+	float displacementLengthSquared = glm::dot(displacement, displacement);
+
+	float closestPathPoint = (displacementLengthSquared > 0.0f) ?
+		glm::clamp(glm::dot(centersDelta, displacement) / displacementLengthSquared, 0.0f, 1.0f) : 0.0f;
+
+	vector3 closestDelta = centersDelta - displacement * closestPathPoint;
+
+	if (glm::dot(closestDelta, closestDelta) > boundingRadiusesSum * boundingRadiusesSum)
+		return false;
+
+	// Only the position changes on the way, so the separating axes stay the same
+	vector3 axes[MAX_SEPARATING_AXES_COUNT];
+	size_t axesCount = collectSeparatingAxes(obstacle, axes, nullptr);
+
+	float enterTime = -std::numeric_limits<float>::infinity();
+	float exitTime = std::numeric_limits<float>::infinity();
+
+	vector3 enterNormal;
+	float enterSpeed = 0.0f;
+
+	for (size_t axisIndex = 0; axisIndex < axesCount; axisIndex++) {
+		const vector3& axis = axes[axisIndex];
+
+		ProjectionBounds projection = getProjection(axis);
+		ProjectionBounds obstacleProjection = obstacle.getProjection(axis);
+
+		float speed = glm::dot(displacement, axis);
+
+		if (std::abs(speed) <= 1e-6f) {
+			// Projections don't move relative to each other, so they should overlap all the way
+			if (projection.max <= obstacleProjection.min || projection.min >= obstacleProjection.max)
+				return false;
+
+			continue;
+		}
+
+		float axisEnterTime = (speed > 0.0f) ? 
+			(obstacleProjection.min - projection.max) / speed : (obstacleProjection.max - projection.min) / speed;
+
+		float axisExitTime = (speed > 0.0f) ?
+			(obstacleProjection.max - projection.min) / speed : (obstacleProjection.min - projection.max) / speed;
+
+		if (axisEnterTime > enterTime) {
+			enterTime = axisEnterTime;
+			enterNormal = (speed > 0.0f) ? -axis : axis;
+			enterSpeed = std::abs(speed);
+		}
+
+		exitTime = std::min(exitTime, axisExitTime);
+
+		if (enterTime > exitTime)
+			return false;
+	}
+
+	if (enterTime > 1.0f || exitTime < 0.0f)
+		return false;
+
+	// Touching box moving deeper hits the obstacle at once
+	if (enterTime < 0.0f) {
+		if (-enterTime * enterSpeed > SWEEP_INITIAL_OVERLAP_TOLERANCE)
+			return false;
+
+		enterTime = 0.0f;
+	}
+
+	timeOfImpact = enterTime;
+	normal = enterNormal;
+
+	return true;
+}
+
+size_t OBB::collectSeparatingAxes(const OBB & second, vector3 * axes, size_t* featuresIds) const
+{
+	size_t axesCount = 0;
+
+	// Face normals separate boxes much more often than the edges cross products
+	for (size_t featureId = 0; featureId < SEPARATING_FEATURES_COUNT; featureId++) {
+		if (!getSeparatingAxis(second, featureId, axes[axesCount]))
+			continue;
+
+		if (featuresIds != nullptr)
+			featuresIds[axesCount] = featureId;
+
+		axesCount++;
+	}
+
+	return axesCount;
+}
+
+bool OBB::getSeparatingAxis(const OBB & second, size_t featureId, vector3 & axis) const
+{
+	_assert(featureId < SEPARATING_FEATURES_COUNT);
+
+	if (featureId < 3) {
+		axis = m_normals[featureId];
+		return true;
+	}
+
+	if (featureId < 6) {
+		axis = second.m_normals[featureId - 3];
+		return true;
+	}
+
+	size_t edgesPairIndex = featureId - 6;
+	axis = glm::cross(m_normals[edgesPairIndex / 3], second.m_normals[edgesPairIndex % 3]);
+
+	float axisLengthSquared = glm::dot(axis, axis);
+
+	// Parallel edges give no new axis
+	if (axisLengthSquared <= 1e-6f)
+		return false;
+
+	axis /= std::sqrt(axisLengthSquared);
+
+	return true;
+}
+
+void OBB::calculateOverlaps(const OBB & second, const vector3 * axes, float * overlaps) const
+{
+#ifdef OBB_SSE_ENABLED
+	__m128 axesX = _mm_set_ps(axes[3].x, axes[2].x, axes[1].x, axes[0].x);
+	__m128 axesY = _mm_set_ps(axes[3].y, axes[2].y, axes[1].y, axes[0].y);
+	__m128 axesZ = _mm_set_ps(axes[3].z, axes[2].z, axes[1].z, axes[0].z);
+
+	__m128 signMask = _mm_set1_ps(-0.0f);
+
+	auto projectOnAxes = [&](const vector3& vector) {
+		return _mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(axesX, _mm_set1_ps(vector.x)),
+			_mm_mul_ps(axesY, _mm_set1_ps(vector.y))),
+			_mm_mul_ps(axesZ, _mm_set1_ps(vector.z)));
+	};
+
+	auto projectRadiusOnAxes = [&](const vector3* halfAxes) {
+		return _mm_add_ps(_mm_add_ps(
+			_mm_andnot_ps(signMask, projectOnAxes(halfAxes[0])),
+			_mm_andnot_ps(signMask, projectOnAxes(halfAxes[1]))),
+			_mm_andnot_ps(signMask, projectOnAxes(halfAxes[2])));
 	};
+
+	__m128 firstCenter = projectOnAxes(m_center);
+	__m128 firstRadius = projectRadiusOnAxes(m_halfAxes);
+
+	__m128 secondCenter = projectOnAxes(second.m_center);
+	__m128 secondRadius = projectRadiusOnAxes(second.m_halfAxes);
+
+	// Distance to move the projections apart along the direction between the centers, negative for the separated
+	// projections. It equals the overlap length unless one projection contains the other one
+	__m128 overlap = _mm_sub_ps(_mm_add_ps(firstRadius, secondRadius),
+		_mm_andnot_ps(signMask, _mm_sub_ps(firstCenter, secondCenter)));
+
+	_mm_storeu_ps(overlaps, overlap);
+#else
+	for (size_t axisIndex = 0; axisIndex < SEPARATING_AXES_BATCH_SIZE; axisIndex++) {
+		ProjectionBounds firstProjection = this->getProjection(axes[axisIndex]);
+		ProjectionBounds secondProjection = second.getProjection(axes[axisIndex]);
+
+		float radiusesSum = 0.5f * (firstProjection.max - firstProjection.min + secondProjection.max - secondProjection.min);
+		float centersDistance = 0.5f * std::abs(firstProjection.max + firstProjection.min - 
+			secondProjection.max - secondProjection.min);
+
+		overlaps[axisIndex] = radiusesSum - centersDistance;
+	}
+#endif
+}
+
+std::vector<vector3> OBB::getNormals() const {
+	return std::vector<vector3>(m_normals, m_normals + 3);
 }
 
 ProjectionBounds OBB::getProjection(const vector3& direction) const {
-	std::vector<vector3> vertices = getVertices();
+	float center = glm::dot(m_center, direction);
+	float radius = abs(glm::dot(m_halfAxes[0], direction)) + 
+		abs(glm::dot(m_halfAxes[1], direction)) + 
+		abs(glm::dot(m_halfAxes[2], direction));
 
 	ProjectionBounds projection;
-	projection.min = std::numeric_limits<float>::infinity();
-	projection.max = -std::numeric_limits<float>::infinity();
-
-	for (auto& vertex : vertices) {
-		float projectionValue = glm::dot(vertex, direction);
-		if (projectionValue < projection.min) { projection.min = projectionValue; }
-		if (projectionValue > projection.max) { projection.max = projectionValue; }
-	}
+	projection.min = center - radius;
+	projection.max = center + radius;
 
 	return projection;
 }
@@ -139,6 +460,79 @@ vector3 OBB::getCenter() const
 	return m_center;
 }
 
+float OBB::getBoundingRadius() const
+{
+	return m_boundingRadius;
+}
+
+AABB OBB::getBoundingBox() const
+{
+	vector3 extents = glm::abs(m_halfAxes[0]) + glm::abs(m_halfAxes[1]) + glm::abs(m_halfAxes[2]);
+
+	return AABB(m_center - extents, m_center + extents);
+}
+
+Sphere OBB::getBoundingSphere() const
+{
+	return Sphere(m_center, m_boundingRadius);
+}
+
+vector3 OBB::getLocalPosition(const vector3 & point) const
+{
+	vector3 offset = point - m_center;
+
+	return vector3(glm::dot(offset, m_basis[0]), glm::dot(offset, m_basis[1]), glm::dot(offset, m_basis[2]));
+}
+
+float OBB::getSignedDistance(const vector3 & point) const
+{
+	vector3 faceDistances = glm::abs(getLocalPosition(point)) - 0.5f * m_size;
+
+	float outsideDistance = glm::length(glm::max(faceDistances, vector3(0.0f)));
+	float insideDistance = std::min(std::max(faceDistances.x, std::max(faceDistances.y, faceDistances.z)), 0.0f);
+
+	return outsideDistance + insideDistance;
+}
+
+bool OBB::intersectsSphere(const vector3 & center, float radius, Intersection & intersection) const
+{
+	vector3 halfSize = 0.5f * m_size;
+
+	vector3 localCenter = getLocalPosition(center);
+	vector3 localOffset = localCenter - glm::clamp(localCenter, -halfSize, halfSize);
+
+	float distanceSquared = glm::dot(localOffset, localOffset);
+
+	if (distanceSquared > radius * radius)
+		return false;
+
+	if (distanceSquared > 0.0f) {
+		float distance = std::sqrt(distanceSquared);
+		vector3 offset = m_basis[0] * localOffset.x + m_basis[1] * localOffset.y + m_basis[2] * localOffset.z;
+
+		intersection.setDirection(offset / distance);
+		intersection.setDepth(radius - distance);
+		intersection.setFeatureId(0);
+
+		return true;
+	}
+
+	// The center is inside of the box, so the sphere is pushed through the nearest face
+	vector3 faceDistances = halfSize - glm::abs(localCenter);
+	size_t nearestAxis = 0;
+
+	for (size_t axis = 1; axis < 3; axis++) {
+		if (faceDistances[axis] < faceDistances[nearestAxis])
+			nearestAxis = axis;
+	}
+
+	intersection.setDirection(localCenter[nearestAxis] < 0.0f ? -m_basis[nearestAxis] : m_basis[nearestAxis]);
+	intersection.setDepth(radius + faceDistances[nearestAxis]);
+	intersection.setFeatureId(0);
+
+	return true;
+}
+
 bool OBB::intersects(const Ray & ray, float & distance) const
 {
 	float eps = 1e-5f;
@@ -1,9 +1,12 @@
 #pragma once
 
-#include <Engine\Components\Math\types.h>
-#include <Engine\Components\Physics\Ray.h>
-#include <Engine\Components\Physics\ProjectionBounds.h>
-#include <Engine\Components\Physics\Intersection.h>
+#include <Engine/Components/Math/types.h>
+#include <Engine/Components/Physics/Ray.h>
+#include <Engine/Components/Physics/ProjectionBounds.h>
+#include <Engine/Components/Physics/Intersection.h>
+#include <Engine/Components/Physics/Colliders/AABB.h>
+#include <Engine/Components/Physics/Colliders/Sphere.h>
+#include <Engine/Components/Physics/Colliders/Capsule.h>
 
 #include <vector>
 
@@ -11,11 +14,26 @@ class OBB {
 public:
 	OBB(const OBB& obb, const matrix4& transform);
 	OBB(const vector3& origin, const vector3& v1, const vector3& v2, const vector3& v3);
+	OBB(const AABB& box);
 	~OBB();
 
 	bool intersects(const OBB& second, Intersection& intersection) const;
+
+	// Directions of the intersections push this box out of the second collider
+	bool intersects(const AABB& box, Intersection& intersection) const;
+	bool intersects(const Sphere& sphere, Intersection& intersection) const;
+	bool intersects(const Capsule& capsule, Intersection& intersection) const;
+
+	// Tests a single axis of the separating axis test, the one that separated the boxes or gave the contact
+	// on the previous steps is likely to decide the result again
+	bool isSeparatedBy(const OBB& second, size_t featureId) const;
 	bool intersects(const Ray& ray, float& distance) const;
 
+	// Finds the first contact of the box moving by the displacement with the obstacle.
+	// Time of impact is a fraction of the displacement, the normal points from the obstacle towards the box.
+	// Boxes which touch at the start are hit at once, deeper intersections are left to the penetration resolution
+	bool sweep(const vector3& displacement, const OBB& obstacle, float& timeOfImpact, vector3& normal) const;
+
 	std::vector<vector3> getNormals() const;
 	ProjectionBounds getProjection(const vector3& direction) const;
 
@@ -23,9 +41,34 @@ public:
 
 	vector3 getCenter() const;
 
+	// Radius of a sphere around the center that encloses the box
+	float getBoundingRadius() const;
+
+	AABB getBoundingBox() const;
+	Sphere getBoundingSphere() const;
+
 private:
 	void calculateProperties();
 
+	// Position of the point along the box axes relative to the center
+	vector3 getLocalPosition(const vector3& point) const;
+
+	// Distance from the surface, negative inside of the box
+	float getSignedDistance(const vector3& point) const;
+
+	// The direction pushes the sphere out of the box
+	bool intersectsSphere(const vector3& center, float radius, Intersection& intersection) const;
+
+	// Fills the axes to test in order of the most likely separation, degenerate axes are skipped.
+	// Features ids are the indices of the axes among all 15 ones, they are not filled if null
+	size_t collectSeparatingAxes(const OBB& second, vector3* axes, size_t* featuresIds) const;
+
+	// Returns false for the degenerate axis
+	bool getSeparatingAxis(const OBB& second, size_t featureId, vector3& axis) const;
+
+	// Overlap lengths of the projections of the boxes on four axes
+	void calculateOverlaps(const OBB& second, const vector3* axes, float* overlaps) const;
+
 private:
 	vector3 m_origin;
 	vector3 m_vertex1;
@@ -36,4 +79,21 @@ private:
 	vector3 m_size;
 
 	vector3 m_center;
+
+	// Face normals and half of the edges from the center, precalculated for the separating axis test
+	vector3 m_normals[3];
+	vector3 m_halfAxes[3];
+
+	float m_boundingRadius;
+
+private:
+	// Face normals of both boxes and cross products of their edges
+	static const size_t SEPARATING_FEATURES_COUNT = 15;
+
+	// All the axes rounded up to the whole number of batches
+	static const size_t MAX_SEPARATING_AXES_COUNT = 16;
+	static const size_t SEPARATING_AXES_BATCH_SIZE = 4;
+
+	// Golden section steps of the search for the capsule segment point deepest in the box
+	static const size_t CAPSULE_SEARCH_ITERATIONS_COUNT = 24;
 };
\ No newline at end of file
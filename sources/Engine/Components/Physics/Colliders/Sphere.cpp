@@ -1,4 +1,9 @@
 #include "Sphere.h"
+#include "OBB.h"
+#include "Capsule.h"
+
+#include <cmath>
+#include <limits>
 
 Sphere::Sphere()
 	: m_center(), m_radius(0.0f)
@@ -58,3 +63,103 @@ bool Sphere::isRayIntersecting(const Ray& ray)
 	return true;
 
 }
+
+bool Sphere::intersects(const AABB & box, Intersection & intersection) const
+{
+	vector3 boxMin = box.getMin();
+	vector3 boxMax = box.getMax();
+
+	vector3 closestPoint = glm::clamp(m_center, boxMin, boxMax);
+	vector3 offset = m_center - closestPoint;
+
+	float distanceSquared = glm::dot(offset, offset);
+
+	if (distanceSquared > m_radius * m_radius)
+		return false;
+
+	if (distanceSquared > 0.0f) {
+		float distance = std::sqrt(distanceSquared);
+
+		intersection.setDirection(offset / distance);
+		intersection.setDepth(m_radius - distance);
+		intersection.setFeatureId(0);
+
+		return true;
+	}
+
+	// The center is inside of the box, so the sphere is pushed through the nearest face
+	size_t nearestAxis = 0;
+	float nearestFaceDistance = std::numeric_limits<float>::infinity();
+	float nearestFaceSign = 1.0f;
+
+	for (size_t axis = 0; axis < 3; axis++) {
+		float minFaceDistance = m_center[axis] - boxMin[axis];
+		float maxFaceDistance = boxMax[axis] - m_center[axis];
+
+		if (minFaceDistance < nearestFaceDistance) {
+			nearestAxis = axis;
+			nearestFaceDistance = minFaceDistance;
+			nearestFaceSign = -1.0f;
+		}
+
+		if (maxFaceDistance < nearestFaceDistance) {
+			nearestAxis = axis;
+			nearestFaceDistance = maxFaceDistance;
+			nearestFaceSign = 1.0f;
+		}
+	}
+
+	vector3 direction(0.0f);
+	direction[nearestAxis] = nearestFaceSign;
+
+	intersection.setDirection(direction);
+	intersection.setDepth(m_radius + nearestFaceDistance);
+	intersection.setFeatureId(0);
+
+	return true;
+}
+
+bool Sphere::intersects(const Sphere & second, Intersection & intersection) const
+{
+	vector3 centersDelta = m_center - second.m_center;
+	float radiusesSum = m_radius + second.m_radius;
+
+	float distanceSquared = glm::dot(centersDelta, centersDelta);
+
+	if (distanceSquared > radiusesSum * radiusesSum)
+		return false;
+
+	float distance = std::sqrt(distanceSquared);
+
+	// Concentric spheres have no preferred direction, so they are separated vertically
+	intersection.setDirection(distance > 1e-6f ? centersDelta / distance : vector3(0.0f, 1.0f, 0.0f));
+	intersection.setDepth(radiusesSum - distance);
+	intersection.setFeatureId(0);
+
+	return true;
+}
+
+bool Sphere::intersects(const OBB & box, Intersection & intersection) const
+{
+	if (!box.intersects(*this, intersection))
+		return false;
+
+	intersection.setDirection(-intersection.getDirection());
+
+	return true;
+}
+
+bool Sphere::intersects(const Capsule & capsule, Intersection & intersection) const
+{
+	return intersects(Sphere(capsule.getClosestPoint(m_center), capsule.getRadius()), intersection);
+}
+
+AABB Sphere::getBoundingBox() const
+{
+	return AABB(m_center - vector3(m_radius), m_center + vector3(m_radius));
+}
+
+Sphere Sphere::getBoundingSphere() const
+{
+	return *this;
+}
@@ -1,7 +1,12 @@
 #pragma once
 
-#include <Engine\Components\Math\types.h>
-#include <Engine\Components\Physics\Ray.h>
+#include <Engine/Components/Math/types.h>
+#include <Engine/Components/Physics/Ray.h>
+#include <Engine/Components/Physics/Intersection.h>
+#include <Engine/Components/Physics/Colliders/AABB.h>
+
+class OBB;
+class Capsule;
 
 class Sphere {
 public:
@@ -16,6 +21,16 @@ public:
 	void setRadius(float radius);
 
 	bool isRayIntersecting(const Ray& ray);
+
+	// Directions of the intersections push this sphere out of the second collider
+	bool intersects(const AABB& box, Intersection& intersection) const;
+	bool intersects(const Sphere& second, Intersection& intersection) const;
+	bool intersects(const OBB& box, Intersection& intersection) const;
+	bool intersects(const Capsule& capsule, Intersection& intersection) const;
+
+	AABB getBoundingBox() const;
+	Sphere getBoundingSphere() const;
+
 private:
 	vector3 m_center;
 	float m_radius;
@@ -0,0 +1,24 @@
+#include "ContactManifold.h"
+
+#include <functional>
+
+bool ContactKey::operator==(const ContactKey & key) const
+{
+	return body == key.body && colliderIndex == key.colliderIndex &&
+		obstacle == key.obstacle && obstacleColliderIndex == key.obstacleColliderIndex;
+}
+
+size_t ContactKeyHash::operator()(const ContactKey & key) const
+{
+	size_t hash = std::hash<const RigidBody*>()(key.body);
+
+	auto combine = [&hash](size_t value) {
+		hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+	};
+
+	combine(key.colliderIndex);
+	combine(std::hash<const RigidBody*>()(key.obstacle));
+	combine(key.obstacleColliderIndex);
+
+	return hash;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <Engine\Components\Math\types.h>
+
+class RigidBody;
+
+// Identifies a pair of colliders in contact, the obstacle is null for the static colliders
+struct ContactKey {
+	const RigidBody* body;
+	size_t colliderIndex;
+
+	const RigidBody* obstacle;
+	size_t obstacleColliderIndex;
+
+	bool operator==(const ContactKey& key) const;
+};
+
+struct ContactKeyHash {
+	size_t operator()(const ContactKey& key) const;
+};
+
+// Contact found on the previous steps, it stays valid while the colliders keep their relative placement
+struct ContactManifold {
+	// Direction to push the body out of the obstacle
+	vector3 normal;
+	float depth;
+
+	// Separating axis that gave the contact
+	size_t featureId;
+
+	// Placement of the body relative to the obstacle when the contact was found
+	vector3 relativePosition;
+	quaternion bodyOrientation;
+	quaternion obstacleOrientation;
+
+	// Last step the contact was confirmed on
+	size_t stepIndex;
+};
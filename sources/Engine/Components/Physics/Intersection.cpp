@@ -1,12 +1,12 @@
 #include "Intersection.h"
 
 Intersection::Intersection()
-	: m_direction(0.0f, 0.0f, 0.0f), m_depth(0.0f)
+	: m_direction(0.0f, 0.0f, 0.0f), m_depth(0.0f), m_featureId(0)
 {
 }
 
 Intersection::Intersection(const vector3 & direction, float depth)
-	: m_direction(direction), m_depth(depth)
+	: m_direction(direction), m_depth(depth), m_featureId(0)
 {
 
 }
@@ -34,3 +34,13 @@ void Intersection::setDepth(float depth)
 {
 	m_depth = depth;
 }
+
+size_t Intersection::getFeatureId() const
+{
+	return m_featureId;
+}
+
+void Intersection::setFeatureId(size_t featureId)
+{
+	m_featureId = featureId;
+}
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <Engine\Components\Math\types.h>
+#include <Engine/Components/Math/types.h>
 
 struct Intersection {
 public:
@@ -14,7 +14,13 @@ public:
 	float getDepth() const;
 	void setDepth(float depth);
 
+	// Identifies the separating axis of the smallest overlap, which stays the same while the contact persists
+	size_t getFeatureId() const;
+	void setFeatureId(size_t featureId);
+
 private:
 	vector3 m_direction;
 	float m_depth;
+
+	size_t m_featureId;
 };
\ No newline at end of file
@@ -0,0 +1,625 @@
+#include "PhysicsWorld.h"
+
+#include <Engine\assertions.h>
+
+#include <algorithm>
+
+// Bodies which are a little above the floor still stand on it
+static const float FLOOR_CONTACT_TOLERANCE = 0.01f;
+
+// Bodies slower than this for TIME_TO_SLEEP seconds fall asleep
+static const float SLEEP_VELOCITY_THRESHOLD = 0.05f;
+static const float TIME_TO_SLEEP = 0.5f;
+
+// Contacts are reused while the body moves relative to the obstacle less than this
+static const float CONTACT_REUSE_DISTANCE = 0.01f;
+
+// Contacts separated less than this are kept, so resting contacts persist between the steps instead of flickering
+static const float PENETRATION_SLOP = 0.001f;
+
+// Swept bodies stop this far before the obstacles, so they don't start the next sweep touching them
+static const float SWEEP_CONTACT_OFFSET = 0.001f;
+
+PhysicsWorld::PhysicsWorld(float stepDuration, JobSystem* jobSystem)
+	: m_stepDuration(stepDuration),
+	m_accumulatedTime(0.0f),
+	m_jobSystem(jobSystem),
+	m_gravity(0.0f, -9.8f, 0.0f),
+	m_staticColliders(nullptr),
+	m_staticTriangles(nullptr),
+	m_broadphase(0.1f),
+	m_stepIndex(0)
+{
+	_assert(stepDuration > 0.0f);
+}
+
+PhysicsWorld::~PhysicsWorld()
+{
+	for (RigidBody* body : m_bodies)
+		delete body;
+}
+
+void PhysicsWorld::setStaticGeometry(const std::vector<OBB>* colliders,
+	const BoundingVolumeHierarchy * collidersHierarchy,
+	const TriangleMeshHierarchy * trianglesHierarchy)
+{
+	m_staticColliders = colliders;
+	m_staticTriangles = trianglesHierarchy;
+
+	m_contactManifolds.clear();
+
+	m_broadphase.setStaticHierarchy(collidersHierarchy);
+}
+
+RigidBody * PhysicsWorld::createRigidBody(RigidBody::Type type, Transform * transform, const std::vector<OBB>& colliders)
+{
+	RigidBody* body = new RigidBody(type, transform, colliders);
+	body->m_proxyId = m_broadphase.addDynamicCollider(body->getWorldBounds(), body);
+	body->m_index = m_bodies.size();
+
+	m_bodies.push_back(body);
+
+	wakeUpBodiesAround(body);
+
+	return body;
+}
+
+void PhysicsWorld::destroyRigidBody(RigidBody * body)
+{
+	auto bodyIt = std::find(m_bodies.begin(), m_bodies.end(), body);
+	_assert(bodyIt != m_bodies.end());
+
+	// Bodies resting on the removed one should fall
+	wakeUpBodiesAround(body);
+
+	for (auto manifoldIt = m_contactManifolds.begin(); manifoldIt != m_contactManifolds.end(); ) {
+		if (manifoldIt->first.body == body || manifoldIt->first.obstacle == body)
+			manifoldIt = m_contactManifolds.erase(manifoldIt);
+		else
+			manifoldIt++;
+	}
+
+	m_broadphase.removeDynamicCollider(body->m_proxyId);
+	bodyIt = m_bodies.erase(bodyIt);
+
+	for (; bodyIt != m_bodies.end(); bodyIt++)
+		(*bodyIt)->m_index--;
+
+	delete body;
+}
+
+void PhysicsWorld::setGravity(const vector3 & gravity)
+{
+	m_gravity = gravity;
+}
+
+vector3 PhysicsWorld::getGravity() const
+{
+	return m_gravity;
+}
+
+float PhysicsWorld::getStepDuration() const
+{
+	return m_stepDuration;
+}
+
+void PhysicsWorld::update(float deltaTime)
+{
+	m_accumulatedTime += deltaTime;
+
+	size_t stepsCount = (size_t)(m_accumulatedTime / m_stepDuration);
+
+	if (stepsCount > MAX_STEPS_PER_UPDATE) {
+		stepsCount = MAX_STEPS_PER_UPDATE;
+		m_accumulatedTime = m_stepDuration * MAX_STEPS_PER_UPDATE;
+	}
+
+	m_accumulatedTime -= m_stepDuration * stepsCount;
+
+	if (stepsCount > 0) {
+		synchronizeWithTransforms();
+
+		// The movement requested by the game is spread evenly over the steps of the update
+		for (RigidBody* body : m_bodies) {
+			if (body->m_type == RigidBody::Type::Dynamic) {
+				body->m_pendingMovement /= (float)stepsCount;
+			}
+		}
+
+		for (size_t stepIndex = 0; stepIndex < stepsCount; stepIndex++)
+			step();
+
+		for (RigidBody* body : m_bodies)
+			body->m_pendingMovement = vector3(0.0f);
+	}
+
+	interpolateTransforms(getInterpolationFactor());
+}
+
+float PhysicsWorld::getInterpolationFactor() const
+{
+	return m_accumulatedTime / m_stepDuration;
+}
+
+const Broadphase * PhysicsWorld::getBroadphase() const
+{
+	return &m_broadphase;
+}
+
+void PhysicsWorld::synchronizeWithTransforms()
+{
+	for (RigidBody* body : m_bodies) {
+		quaternion orientation = body->m_transform->getOrientation();
+
+		if (body->m_type == RigidBody::Type::Dynamic) {
+			// The colliders turn with the transform, so a sleeping body could be turned into an obstacle
+			if (body->m_isSleeping && orientation != body->m_orientation)
+				body->wakeUp();
+
+			body->m_orientation = orientation;
+			continue;
+		}
+
+		body->m_previousPosition = body->m_position;
+
+		vector3 position = body->m_transform->getPosition();
+
+		body->m_isMoving = position != body->m_position || orientation != body->m_orientation;
+
+		if (!body->m_isMoving)
+			continue;
+
+		body->m_position = position;
+		body->m_orientation = orientation;
+
+		m_broadphase.updateDynamicCollider(body->m_proxyId, body->getWorldBounds());
+		wakeUpBodiesAround(body);
+	}
+}
+
+void PhysicsWorld::step()
+{
+	m_stepIndex++;
+
+	for (RigidBody* body : m_bodies) {
+		if (body->m_type != RigidBody::Type::Dynamic || body->m_isSleeping)
+			continue;
+
+		body->m_previousPosition = body->m_position;
+
+		if (body->m_isGravityEnabled && !body->m_isOnFloor)
+			body->m_velocity += m_gravity * m_stepDuration;
+
+		sweep(body, body->m_velocity * m_stepDuration + body->m_pendingMovement);
+	}
+
+	resolveCollisions();
+	updateFloorContacts();
+
+	for (RigidBody* body : m_bodies) {
+		if (body->m_type == RigidBody::Type::Dynamic && !body->m_isSleeping)
+			m_broadphase.updateDynamicCollider(body->m_proxyId, body->getWorldBounds());
+	}
+
+	updateSleeping();
+	removeLostContacts();
+}
+
+void PhysicsWorld::updateSleeping()
+{
+	m_islandsParents.resize(m_bodies.size());
+
+	for (size_t bodyIndex = 0; bodyIndex < m_bodies.size(); bodyIndex++)
+		m_islandsParents[bodyIndex] = bodyIndex;
+
+	float restVelocityLimit = SLEEP_VELOCITY_THRESHOLD * SLEEP_VELOCITY_THRESHOLD;
+	float restMovementLimit = restVelocityLimit * m_stepDuration * m_stepDuration;
+
+	for (RigidBody* body : m_bodies) {
+		if (body->m_type != RigidBody::Type::Dynamic || body->m_isSleeping)
+			continue;
+
+		vector3 movement = body->m_position - body->m_previousPosition;
+
+		bool isResting = glm::dot(body->m_velocity, body->m_velocity) < restVelocityLimit &&
+			glm::dot(movement, movement) < restMovementLimit;
+
+		body->m_restTime = isResting ? body->m_restTime + m_stepDuration : 0.0f;
+
+		// Dynamic bodies don't collide with each other yet, so there are no contacts to link them.
+		// Bodies with overlapping broadphase bounds form a proximity island instead, moving obstacles keep the body awake
+		m_dynamicCollidersCandidates.clear();
+		m_broadphase.queryDynamicColliders(body->getWorldBounds(), m_dynamicCollidersCandidates);
+
+		for (Broadphase::ProxyId proxyId : m_dynamicCollidersCandidates) {
+			RigidBody* neighbour = static_cast<RigidBody*>(m_broadphase.getUserData(proxyId));
+
+			if (neighbour == body)
+				continue;
+
+			if (neighbour->m_type == RigidBody::Type::Kinematic) {
+				if (neighbour->m_isMoving)
+					body->m_restTime = 0.0f;
+
+				continue;
+			}
+
+			// The awake body wakes up the whole island near it
+			if (neighbour->m_isSleeping)
+				neighbour->wakeUp();
+
+			mergeIslands(body->m_index, neighbour->m_index);
+		}
+	}
+
+	// Island sleeps only when all of its bodies have been resting long enough
+	m_islandsRestTimes.assign(m_bodies.size(), std::numeric_limits<float>::infinity());
+
+	for (RigidBody* body : m_bodies) {
+		if (body->m_type != RigidBody::Type::Dynamic || body->m_isSleeping)
+			continue;
+
+		float& islandRestTime = m_islandsRestTimes[findIslandRoot(body->m_index)];
+		islandRestTime = std::min(islandRestTime, body->m_restTime);
+	}
+
+	for (RigidBody* body : m_bodies) {
+		if (body->m_type != RigidBody::Type::Dynamic || body->m_isSleeping)
+			continue;
+
+		if (m_islandsRestTimes[findIslandRoot(body->m_index)] < TIME_TO_SLEEP)
+			continue;
+
+		body->m_isSleeping = true;
+		body->m_velocity = vector3(0.0f);
+		body->m_previousPosition = body->m_position;
+		body->m_transform->setPosition(body->m_position);
+	}
+}
+
+size_t PhysicsWorld::findIslandRoot(size_t bodyIndex)
+{
+	while (m_islandsParents[bodyIndex] != bodyIndex) {
+		// Path halving keeps the trees flat
+		m_islandsParents[bodyIndex] = m_islandsParents[m_islandsParents[bodyIndex]];
+		bodyIndex = m_islandsParents[bodyIndex];
+	}
+
+	return bodyIndex;
+}
+
+void PhysicsWorld::mergeIslands(size_t firstBodyIndex, size_t secondBodyIndex)
+{
+	size_t firstRoot = findIslandRoot(firstBodyIndex);
+	size_t secondRoot = findIslandRoot(secondBodyIndex);
+
+	if (firstRoot != secondRoot)
+		m_islandsParents[secondRoot] = firstRoot;
+}
+
+void PhysicsWorld::wakeUpBodiesAround(const RigidBody * body)
+{
+	m_dynamicCollidersCandidates.clear();
+	m_broadphase.queryDynamicColliders(body->getWorldBounds(), m_dynamicCollidersCandidates);
+
+	for (Broadphase::ProxyId proxyId : m_dynamicCollidersCandidates) {
+		RigidBody* neighbour = static_cast<RigidBody*>(m_broadphase.getUserData(proxyId));
+
+		if (neighbour->m_type == RigidBody::Type::Dynamic && neighbour->m_isSleeping)
+			neighbour->wakeUp();
+	}
+}
+
+void PhysicsWorld::sweep(RigidBody * body, vector3 displacement)
+{
+	for (size_t iteration = 0; iteration < MAX_SWEEP_ITERATIONS; iteration++) {
+		float displacementLength = glm::length(displacement);
+
+		if (displacementLength <= 1e-6f)
+			return;
+
+		float timeOfImpact;
+		vector3 normal;
+
+		if (!findTimeOfImpact(body, displacement, timeOfImpact, normal)) {
+			body->m_position += displacement;
+			return;
+		}
+
+		float contactTime = std::max(0.0f, timeOfImpact - SWEEP_CONTACT_OFFSET / displacementLength);
+		body->m_position += displacement * contactTime;
+
+		displacement *= 1.0f - contactTime;
+		displacement -= normal * glm::dot(displacement, normal);
+
+		float approachSpeed = glm::dot(body->m_velocity, normal);
+
+		if (approachSpeed < 0.0f)
+			body->m_velocity -= normal * approachSpeed;
+	}
+}
+
+bool PhysicsWorld::findTimeOfImpact(const RigidBody * body, const vector3 & displacement, float & timeOfImpact, vector3 & normal)
+{
+	bool isHit = false;
+	timeOfImpact = 1.0f;
+
+	float obstacleTimeOfImpact;
+	vector3 obstacleNormal;
+
+	auto checkObstacle = [&](const OBB& collider, const OBB& obstacle) {
+		if (collider.sweep(displacement, obstacle, obstacleTimeOfImpact, obstacleNormal) && obstacleTimeOfImpact < timeOfImpact) {
+			timeOfImpact = obstacleTimeOfImpact;
+			normal = obstacleNormal;
+			isHit = true;
+		}
+	};
+
+	for (size_t colliderIndex = 0; colliderIndex < body->m_colliders.size(); colliderIndex++) {
+		OBB collider = body->getWorldCollider(colliderIndex);
+
+		// Only the obstacles near the path are tested
+		AABB sweptBounds = collider.getBoundingBox().getSwept(displacement);
+
+		if (m_staticColliders != nullptr) {
+			m_staticCollidersCandidates.clear();
+			m_broadphase.queryStaticColliders(sweptBounds, m_staticCollidersCandidates);
+
+			for (size_t staticColliderIndex : m_staticCollidersCandidates)
+				checkObstacle(collider, (*m_staticColliders)[staticColliderIndex]);
+		}
+
+		m_dynamicCollidersCandidates.clear();
+		m_broadphase.queryDynamicColliders(sweptBounds, m_dynamicCollidersCandidates);
+
+		for (Broadphase::ProxyId proxyId : m_dynamicCollidersCandidates) {
+			const RigidBody* obstacle = static_cast<const RigidBody*>(m_broadphase.getUserData(proxyId));
+
+			if (obstacle->m_type != RigidBody::Type::Kinematic)
+				continue;
+
+			for (size_t obstacleColliderIndex = 0; obstacleColliderIndex < obstacle->m_colliders.size(); obstacleColliderIndex++)
+				checkObstacle(collider, obstacle->getWorldCollider(obstacleColliderIndex));
+		}
+	}
+
+	return isHit;
+}
+
+void PhysicsWorld::resolveCollisions()
+{
+	collectNarrowphasePairs();
+
+	m_narrowphaseResults.resize(m_narrowphasePairs.size());
+
+	// Every pair writes its own result, so the outcome doesn't depend on the workers count
+	auto testPairs = [this](size_t begin, size_t end) {
+		for (size_t pairIndex = begin; pairIndex < end; pairIndex++)
+			testContact(m_narrowphasePairs[pairIndex], m_narrowphaseResults[pairIndex]);
+	};
+
+	if (m_jobSystem != nullptr)
+		m_jobSystem->parallelFor(m_narrowphasePairs.size(), NARROWPHASE_BATCH_SIZE, testPairs);
+	else
+		testPairs(0, m_narrowphasePairs.size());
+
+	for (size_t pairIndex = 0; pairIndex < m_narrowphasePairs.size(); pairIndex++)
+		applyContact(m_narrowphasePairs[pairIndex], m_narrowphaseResults[pairIndex]);
+}
+
+void PhysicsWorld::collectNarrowphasePairs()
+{
+	m_narrowphasePairs.clear();
+	m_narrowphaseColliders.clear();
+
+	for (RigidBody* body : m_bodies) {
+		if (body->m_type != RigidBody::Type::Dynamic || body->m_isSleeping)
+			continue;
+
+		for (size_t colliderIndex = 0; colliderIndex < body->m_colliders.size(); colliderIndex++) {
+			size_t colliderSlot = m_narrowphaseColliders.size();
+			m_narrowphaseColliders.push_back(body->getWorldCollider(colliderIndex));
+
+			AABB colliderBounds = m_narrowphaseColliders.back().getBoundingBox();
+
+			if (m_staticColliders != nullptr) {
+				m_staticCollidersCandidates.clear();
+				m_broadphase.queryStaticColliders(colliderBounds, m_staticCollidersCandidates);
+
+				for (size_t staticColliderIndex : m_staticCollidersCandidates)
+					m_narrowphasePairs.push_back({ body, { body, colliderIndex, nullptr, staticColliderIndex }, colliderSlot });
+			}
+
+			m_dynamicCollidersCandidates.clear();
+			m_broadphase.queryDynamicColliders(colliderBounds, m_dynamicCollidersCandidates);
+
+			for (Broadphase::ProxyId proxyId : m_dynamicCollidersCandidates) {
+				const RigidBody* obstacle = static_cast<const RigidBody*>(m_broadphase.getUserData(proxyId));
+
+				// Only kinematic bodies are obstacles for now
+				if (obstacle->m_type != RigidBody::Type::Kinematic)
+					continue;
+
+				for (size_t obstacleColliderIndex = 0; obstacleColliderIndex < obstacle->m_colliders.size(); obstacleColliderIndex++)
+					m_narrowphasePairs.push_back({ body, { body, colliderIndex, obstacle, obstacleColliderIndex }, colliderSlot });
+			}
+		}
+	}
+}
+
+void PhysicsWorld::testContact(const NarrowphasePair & pair, ContactTestResult & result) const
+{
+	const ContactKey& key = pair.key;
+	const OBB& collider = m_narrowphaseColliders[pair.colliderSlot];
+
+	vector3 obstaclePosition = (key.obstacle != nullptr) ? key.obstacle->m_position : vector3(0.0f);
+	quaternion obstacleOrientation = (key.obstacle != nullptr) ? key.obstacle->m_orientation : quaternion();
+
+	vector3 relativePosition = pair.body->m_position - obstaclePosition;
+	quaternion bodyOrientation = pair.body->m_transform->getOrientation();
+
+	result.isTouching = false;
+	result.isManifoldReused = false;
+	result.bodyPosition = pair.body->m_position;
+
+	auto manifoldIt = m_contactManifolds.find(key);
+	bool hasManifold = manifoldIt != m_contactManifolds.end();
+
+	if (hasManifold) {
+		const ContactManifold& manifold = manifoldIt->second;
+
+		vector3 placementChange = relativePosition - manifold.relativePosition;
+
+		bool isPlacementKept = glm::dot(placementChange, placementChange) <= CONTACT_REUSE_DISTANCE * CONTACT_REUSE_DISTANCE &&
+			bodyOrientation == manifold.bodyOrientation && obstacleOrientation == manifold.obstacleOrientation;
+
+		if (isPlacementKept) {
+			// The cached contact is shifted by the relative movement instead of the whole separating axis test
+			result.depth = manifold.depth - glm::dot(placementChange, manifold.normal);
+			result.isTouching = result.depth > -PENETRATION_SLOP;
+			result.isManifoldReused = true;
+
+			return;
+		}
+	}
+
+	OBB obstacleCollider = (key.obstacle != nullptr) ? 
+		key.obstacle->getWorldCollider(key.obstacleColliderIndex) : (*m_staticColliders)[key.obstacleColliderIndex];
+
+	// Axis of the last contact is the most likely to separate the colliders now
+	if (hasManifold && collider.isSeparatedBy(obstacleCollider, manifoldIt->second.featureId))
+		return;
+
+	Intersection intersection;
+
+	if (!collider.intersects(obstacleCollider, intersection))
+		return;
+
+	result.isTouching = true;
+	result.depth = intersection.getDepth();
+
+	result.manifold = {
+		intersection.getDirection(),
+		intersection.getDepth(),
+		intersection.getFeatureId(),
+		relativePosition,
+		bodyOrientation,
+		obstacleOrientation,
+		m_stepIndex
+	};
+}
+
+void PhysicsWorld::applyContact(const NarrowphasePair & pair, const ContactTestResult & result)
+{
+	if (!result.isTouching) {
+		m_contactManifolds.erase(pair.key);
+		return;
+	}
+
+	vector3 normal;
+
+	if (result.isManifoldReused) {
+		ContactManifold& manifold = m_contactManifolds.at(pair.key);
+		manifold.stepIndex = m_stepIndex;
+
+		normal = manifold.normal;
+	}
+	else {
+		m_contactManifolds[pair.key] = result.manifold;
+		normal = result.manifold.normal;
+	}
+
+	// The body could be already pushed out by the previous contacts, so only the rest of the depth is resolved
+	float depth = result.depth - glm::dot(pair.body->m_position - result.bodyPosition, normal);
+
+	if (depth > 0.0f)
+		pushOut(pair.body, normal, depth);
+}
+
+void PhysicsWorld::removeLostContacts()
+{
+	for (auto manifoldIt = m_contactManifolds.begin(); manifoldIt != m_contactManifolds.end(); ) {
+		// Contacts of the sleeping bodies are kept for the wake up
+		bool isLost = manifoldIt->second.stepIndex != m_stepIndex && !manifoldIt->first.body->m_isSleeping;
+
+		if (isLost)
+			manifoldIt = m_contactManifolds.erase(manifoldIt);
+		else
+			manifoldIt++;
+	}
+}
+
+void PhysicsWorld::pushOut(RigidBody * body, const vector3 & direction, float depth)
+{
+	// The penetration is resolved fully, the sweep skips the obstacles the body stays inside
+	body->m_position += direction * depth;
+
+	// Velocity towards the obstacle is lost
+	float approachSpeed = glm::dot(body->m_velocity, direction);
+
+	if (approachSpeed < 0.0f)
+		body->m_velocity -= direction * approachSpeed;
+}
+
+void PhysicsWorld::updateFloorContacts()
+{
+	m_floorCheckedBodies.clear();
+	m_floorRays.clear();
+
+	float maxFloorDistance = 0.0f;
+
+	for (RigidBody* body : m_bodies) {
+		if (body->m_type != RigidBody::Type::Dynamic || body->m_isSleeping)
+			continue;
+
+		body->m_isOnFloor = false;
+
+		if (body->m_floorDistance <= 0.0f || m_staticTriangles == nullptr)
+			continue;
+
+		m_floorCheckedBodies.push_back(body);
+		m_floorRays.push_back(Ray(body->m_position, vector3(0.0f, -1.0f, 0.0f)));
+
+		maxFloorDistance = std::max(maxFloorDistance, body->m_floorDistance);
+	}
+
+	if (m_floorRays.empty())
+		return;
+
+	// Rays of all the bodies are traced together to share the hierarchy traversal
+	m_floorHits.resize(m_floorRays.size());
+
+	auto traceRays = [this, maxFloorDistance](size_t begin, size_t end) {
+		m_staticTriangles->raycast(&m_floorRays[begin], end - begin, 
+			maxFloorDistance + FLOOR_CONTACT_TOLERANCE, &m_floorHits[begin]);
+	};
+
+	if (m_jobSystem != nullptr)
+		m_jobSystem->parallelFor(m_floorRays.size(), FLOOR_RAYS_BATCH_SIZE, traceRays);
+	else
+		traceRays(0, m_floorRays.size());
+
+	for (size_t bodyIndex = 0; bodyIndex < m_floorCheckedBodies.size(); bodyIndex++) {
+		RigidBody* body = m_floorCheckedBodies[bodyIndex];
+		const RaycastHit& floorHit = m_floorHits[bodyIndex];
+
+		if (!floorHit.isHit || floorHit.distance > body->m_floorDistance + FLOOR_CONTACT_TOLERANCE)
+			continue;
+
+		body->m_isOnFloor = true;
+
+		// The body is lifted if it has fallen or walked into the floor
+		if (floorHit.distance < body->m_floorDistance)
+			body->m_position.y += body->m_floorDistance - floorHit.distance;
+
+		body->m_velocity.y = std::max(body->m_velocity.y, 0.0f);
+	}
+}
+
+void PhysicsWorld::interpolateTransforms(float interpolationFactor)
+{
+	for (RigidBody* body : m_bodies) {
+		if (body->m_type == RigidBody::Type::Dynamic && !body->m_isSleeping)
+			body->m_transform->setPosition(glm::mix(body->m_previousPosition, body->m_position, interpolationFactor));
+	}
+}
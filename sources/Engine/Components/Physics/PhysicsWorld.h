@@ -0,0 +1,139 @@
+#pragma once
+
+#include <Engine\Components\Math\types.h>
+#include <Engine\Components\Physics\RigidBody.h>
+#include <Engine\Components\Physics\TriangleMeshHierarchy.h>
+#include <Engine\Components\Physics\ContactManifold.h>
+#include <Engine\Components\Physics\Broadphase\Broadphase.h>
+#include <Engine\Components\Threading\JobSystem.h>
+
+#include <vector>
+#include <unordered_map>
+
+// Simulates rigid bodies with a fixed step independent of the update rate of the game
+class PhysicsWorld {
+public:
+	// Narrowphase tests and floor rays are distributed over the job system if it is passed
+	PhysicsWorld(float stepDuration, JobSystem* jobSystem);
+	~PhysicsWorld();
+
+	// Static geometry is expected to be placed in the world space already
+	void setStaticGeometry(const std::vector<OBB>* colliders, 
+		const BoundingVolumeHierarchy* collidersHierarchy, 
+		const TriangleMeshHierarchy* trianglesHierarchy);
+
+	RigidBody* createRigidBody(RigidBody::Type type, Transform* transform, const std::vector<OBB>& colliders);
+	void destroyRigidBody(RigidBody* body);
+
+	void setGravity(const vector3& gravity);
+	vector3 getGravity() const;
+
+	float getStepDuration() const;
+
+	// Runs all the steps that fit into the accumulated time and interpolates
+	// the transforms of the dynamic bodies by the remainder
+	void update(float deltaTime);
+
+	// Part of the next step which is already accumulated
+	float getInterpolationFactor() const;
+
+	const Broadphase* getBroadphase() const;
+
+private:
+	struct NarrowphasePair {
+		RigidBody* body;
+		ContactKey key;
+
+		// Index of the body collider placed in the world
+		size_t colliderSlot;
+	};
+
+	struct ContactTestResult {
+		bool isTouching;
+		bool isManifoldReused;
+
+		float depth;
+
+		// Position of the body the contact was tested at
+		vector3 bodyPosition;
+
+		// Filled for the new contacts only
+		ContactManifold manifold;
+	};
+
+private:
+	// Kinematic bodies follow their transforms, sleeping dynamic bodies wake up when the game turns them
+	void synchronizeWithTransforms();
+	void step();
+
+	// Moves the body as far as the obstacles allow, the rest of the movement slides along them
+	void sweep(RigidBody* body, vector3 displacement);
+	bool findTimeOfImpact(const RigidBody* body, const vector3& displacement, float& timeOfImpact, vector3& normal);
+
+	// Pushes the awake bodies out of the obstacles
+	void resolveCollisions();
+	void collectNarrowphasePairs();
+
+	// Contacts of the previous steps are reused if it is possible, the manifolds are only read here,
+	// so the pairs are tested concurrently
+	void testContact(const NarrowphasePair& pair, ContactTestResult& result) const;
+	void applyContact(const NarrowphasePair& pair, const ContactTestResult& result);
+
+	void removeLostContacts();
+
+	void pushOut(RigidBody* body, const vector3& direction, float depth);
+
+	void updateFloorContacts();
+
+	// Groups the dynamic bodies with overlapping broadphase bounds into proximity islands
+	// and puts the resting islands to sleep
+	void updateSleeping();
+
+	size_t findIslandRoot(size_t bodyIndex);
+	void mergeIslands(size_t firstBodyIndex, size_t secondBodyIndex);
+
+	void wakeUpBodiesAround(const RigidBody* body);
+	void interpolateTransforms(float interpolationFactor);
+
+private:
+	// Steps above the limit are dropped, so a long frame slows the simulation down instead of stalling it
+	static const size_t MAX_STEPS_PER_UPDATE = 8;
+
+	static const size_t MAX_SWEEP_ITERATIONS = 3;
+
+	static const size_t NARROWPHASE_BATCH_SIZE = 16;
+	static const size_t FLOOR_RAYS_BATCH_SIZE = 64;
+
+private:
+	float m_stepDuration;
+	float m_accumulatedTime;
+
+	JobSystem* m_jobSystem;
+
+	vector3 m_gravity;
+
+	const std::vector<OBB>* m_staticColliders;
+	const TriangleMeshHierarchy* m_staticTriangles;
+
+	Broadphase m_broadphase;
+	std::vector<RigidBody*> m_bodies;
+
+	size_t m_stepIndex;
+	std::unordered_map<ContactKey, ContactManifold, ContactKeyHash> m_contactManifolds;
+
+	// Buffers reused between the steps
+	std::vector<size_t> m_staticCollidersCandidates;
+	std::vector<Broadphase::ProxyId> m_dynamicCollidersCandidates;
+
+	std::vector<OBB> m_narrowphaseColliders;
+	std::vector<NarrowphasePair> m_narrowphasePairs;
+	std::vector<ContactTestResult> m_narrowphaseResults;
+
+	std::vector<RigidBody*> m_floorCheckedBodies;
+	std::vector<Ray> m_floorRays;
+	std::vector<RaycastHit> m_floorHits;
+
+	// Union-find forest over the bodies indices
+	std::vector<size_t> m_islandsParents;
+	std::vector<float> m_islandsRestTimes;
+};
@@ -0,0 +1,140 @@
+#include "RigidBody.h"
+
+#include <Engine\assertions.h>
+
+RigidBody::RigidBody(Type type, Transform* transform, const std::vector<OBB>& colliders)
+	: m_type(type),
+	m_transform(transform),
+	m_colliders(colliders),
+	m_position(transform->getPosition()),
+	m_previousPosition(transform->getPosition()),
+	m_velocity(0.0f),
+	m_pendingMovement(0.0f),
+	m_isGravityEnabled(type == Type::Dynamic),
+	m_floorDistance(0.0f),
+	m_isOnFloor(false),
+	m_isSleeping(false),
+	m_restTime(0.0f),
+	m_orientation(transform->getOrientation()),
+	m_isMoving(false),
+	m_index(0),
+	m_proxyId(DynamicBoundingVolumeTree::NULL_PROXY)
+{
+	_assert(!m_colliders.empty());
+}
+
+RigidBody::~RigidBody()
+{
+}
+
+RigidBody::Type RigidBody::getType() const
+{
+	return m_type;
+}
+
+Transform * RigidBody::getTransform() const
+{
+	return m_transform;
+}
+
+const std::vector<OBB>& RigidBody::getColliders() const
+{
+	return m_colliders;
+}
+
+OBB RigidBody::getWorldCollider(size_t colliderIndex) const
+{
+	return OBB(m_colliders[colliderIndex], getPlacementMatrix());
+}
+
+AABB RigidBody::getWorldBounds() const
+{
+	matrix4 placementMatrix = getPlacementMatrix();
+	AABB bounds = OBB(m_colliders[0], placementMatrix).getBoundingBox();
+
+	for (size_t colliderIndex = 1; colliderIndex < m_colliders.size(); colliderIndex++)
+		bounds.merge(OBB(m_colliders[colliderIndex], placementMatrix).getBoundingBox());
+
+	return bounds;
+}
+
+void RigidBody::setPosition(const vector3 & position)
+{
+	m_position = position;
+	m_previousPosition = position;
+	m_pendingMovement = vector3(0.0f);
+
+	m_transform->setPosition(position);
+
+	wakeUp();
+}
+
+vector3 RigidBody::getPosition() const
+{
+	return m_position;
+}
+
+void RigidBody::move(const vector3 & movement)
+{
+	m_pendingMovement += movement;
+
+	if (movement != vector3(0.0f))
+		wakeUp();
+}
+
+void RigidBody::setVelocity(const vector3 & velocity)
+{
+	m_velocity = velocity;
+
+	wakeUp();
+}
+
+vector3 RigidBody::getVelocity() const
+{
+	return m_velocity;
+}
+
+void RigidBody::enableGravity(bool enabled)
+{
+	m_isGravityEnabled = enabled;
+}
+
+bool RigidBody::isGravityEnabled() const
+{
+	return m_isGravityEnabled;
+}
+
+void RigidBody::setFloorDistance(float distance)
+{
+	m_floorDistance = distance;
+}
+
+float RigidBody::getFloorDistance() const
+{
+	return m_floorDistance;
+}
+
+bool RigidBody::isOnFloor() const
+{
+	return m_isOnFloor;
+}
+
+bool RigidBody::isSleeping() const
+{
+	return m_isSleeping;
+}
+
+void RigidBody::wakeUp()
+{
+	m_isSleeping = false;
+	m_restTime = 0.0f;
+}
+
+matrix4 RigidBody::getPlacementMatrix() const
+{
+	// The orientation and the scale are owned by the game, only the position is simulated
+	Transform placement = *m_transform;
+	placement.setPosition(m_position);
+
+	return placement.getTransformationMatrix();
+}
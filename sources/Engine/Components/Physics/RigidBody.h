@@ -0,0 +1,91 @@
+#pragma once
+
+#include <Engine\Components\Math\types.h>
+#include <Engine\Components\Math\Transform.h>
+#include <Engine\Components\Physics\Colliders\OBB.h>
+#include <Engine\Components\Physics\Colliders\AABB.h>
+#include <Engine\Components\Physics\Broadphase\Broadphase.h>
+
+#include <vector>
+
+class RigidBody {
+public:
+	enum class Type {
+		// Simulated by the physics world, the transform receives the interpolated position
+		Dynamic,
+		// Follows its transform, which is controlled by the game, and pushes dynamic bodies out
+		Kinematic
+	};
+
+public:
+	RigidBody(Type type, Transform* transform, const std::vector<OBB>& colliders);
+	~RigidBody();
+
+	Type getType() const;
+	Transform* getTransform() const;
+
+	// Colliders in the local space of the body
+	const std::vector<OBB>& getColliders() const;
+
+	OBB getWorldCollider(size_t colliderIndex) const;
+	AABB getWorldBounds() const;
+
+	// Places the body without interpolation from the previous position
+	void setPosition(const vector3& position);
+	vector3 getPosition() const;
+
+	// Displacement requested by the game for the current update, it is spread over the simulation steps
+	void move(const vector3& movement);
+
+	void setVelocity(const vector3& velocity);
+	vector3 getVelocity() const;
+
+	void enableGravity(bool enabled = true);
+	bool isGravityEnabled() const;
+
+	// Height of the body origin above the floor it stands on, zero disables the floor checks
+	void setFloorDistance(float distance);
+	float getFloorDistance() const;
+
+	bool isOnFloor() const;
+
+	// Sleeping bodies are skipped by the simulation until they are moved, turned or approached by an awake body
+	bool isSleeping() const;
+	void wakeUp();
+
+private:
+	matrix4 getPlacementMatrix() const;
+
+private:
+	Type m_type;
+	Transform* m_transform;
+
+	std::vector<OBB> m_colliders;
+
+	vector3 m_position;
+	vector3 m_previousPosition;
+	vector3 m_velocity;
+
+	vector3 m_pendingMovement;
+
+	bool m_isGravityEnabled;
+
+	float m_floorDistance;
+	bool m_isOnFloor;
+
+	bool m_isSleeping;
+	float m_restTime;
+
+	// Orientation of the transform seen by the last update. Kinematic bodies are synchronized only when
+	// the transform changes, sleeping dynamic bodies are woken up when it turns
+	quaternion m_orientation;
+	bool m_isMoving;
+
+	// Position in the bodies list of the world
+	size_t m_index;
+
+	Broadphase::ProxyId m_proxyId;
+
+private:
+	friend class PhysicsWorld;
+};
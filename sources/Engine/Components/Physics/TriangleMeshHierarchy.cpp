@@ -0,0 +1,346 @@
+#include "TriangleMeshHierarchy.h"
+
+#include <Engine/assertions.h>
+
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1) || defined(__SSE__)
+#define TRIANGLE_MESH_HIERARCHY_SSE_ENABLED
+#include <xmmintrin.h>
+#endif
+
+struct TriangleMeshHierarchy::RaysPacket {
+	alignas(16) float originX[RAYS_PACKET_SIZE];
+	alignas(16) float originY[RAYS_PACKET_SIZE];
+	alignas(16) float originZ[RAYS_PACKET_SIZE];
+
+	alignas(16) float directionX[RAYS_PACKET_SIZE];
+	alignas(16) float directionY[RAYS_PACKET_SIZE];
+	alignas(16) float directionZ[RAYS_PACKET_SIZE];
+
+	alignas(16) float inverseDirectionX[RAYS_PACKET_SIZE];
+	alignas(16) float inverseDirectionY[RAYS_PACKET_SIZE];
+	alignas(16) float inverseDirectionZ[RAYS_PACKET_SIZE];
+
+	// Distance to the nearest hit found so far, negative for unused rays
+	alignas(16) float maxDistance[RAYS_PACKET_SIZE];
+
+	int32 triangleIndex[RAYS_PACKET_SIZE];
+};
+
+// Same tolerance as in Triangle::isRayIntersecting
+static const float RAY_TRIANGLE_EPSILON = 1e-6f;
+
+// Origin lying in the plane of a box side with zero direction component gives 0 * inf = NaN slab distance.
+// Such ray goes along the side and stays in the slab all the way, while min/max would drop the box
+#ifdef TRIANGLE_MESH_HIERARCHY_SSE_ENABLED
+static void getSlabDistances(__m128 t0, __m128 t1, __m128& tMin, __m128& tMax)
+{
+	__m128 isInPlane = _mm_cmpunord_ps(t0, t1);
+
+	tMin = _mm_or_ps(_mm_andnot_ps(isInPlane, _mm_min_ps(t0, t1)),
+		_mm_and_ps(isInPlane, _mm_set1_ps(-std::numeric_limits<float>::infinity())));
+	tMax = _mm_or_ps(_mm_andnot_ps(isInPlane, _mm_max_ps(t0, t1)),
+		_mm_and_ps(isInPlane, _mm_set1_ps(std::numeric_limits<float>::infinity())));
+}
+#else
+static void getSlabDistances(float t0, float t1, float& tMin, float& tMax)
+{
+	bool isInPlane = std::isnan(t0) || std::isnan(t1);
+
+	tMin = isInPlane ? -std::numeric_limits<float>::infinity() : std::min(t0, t1);
+	tMax = isInPlane ? std::numeric_limits<float>::infinity() : std::max(t0, t1);
+}
+#endif
+
+TriangleMeshHierarchy::TriangleMeshHierarchy(const std::vector<vector3>& positions, const std::vector<uint32>& indices)
+	: m_hierarchy(nullptr)
+{
+	_assert(indices.size() % 3 == 0);
+
+	size_t trianglesCount = indices.size() / 3;
+
+	std::vector<AABB> trianglesBounds;
+	trianglesBounds.reserve(trianglesCount);
+
+	for (size_t triangleIndex = 0; triangleIndex < trianglesCount; triangleIndex++) {
+		const vector3& v1 = positions[indices[triangleIndex * 3]];
+		const vector3& v2 = positions[indices[triangleIndex * 3 + 1]];
+		const vector3& v3 = positions[indices[triangleIndex * 3 + 2]];
+
+		trianglesBounds.push_back(AABB(glm::min(v1, glm::min(v2, v3)), glm::max(v1, glm::max(v2, v3))));
+	}
+
+	m_hierarchy = new BoundingVolumeHierarchy(trianglesBounds);
+
+	// Leaves read the triangles sequentially
+	m_triangles.reserve(trianglesCount);
+
+	for (uint32 triangleIndex : m_hierarchy->getItemsIndices()) {
+		const vector3& v1 = positions[indices[triangleIndex * 3]];
+		const vector3& v2 = positions[indices[triangleIndex * 3 + 1]];
+		const vector3& v3 = positions[indices[triangleIndex * 3 + 2]];
+
+		m_triangles.push_back({ v1, v2 - v1, v3 - v1 });
+	}
+}
+
+TriangleMeshHierarchy::~TriangleMeshHierarchy()
+{
+	delete m_hierarchy;
+}
+
+bool TriangleMeshHierarchy::raycast(const Ray & ray, float maxDistance, RaycastHit & hit) const
+{
+	raycastPacket(&ray, 1, maxDistance, &hit);
+
+	return hit.isHit;
+}
+
+void TriangleMeshHierarchy::raycast(const Ray * rays, size_t raysCount, float maxDistance, RaycastHit * hits) const
+{
+	for (size_t packetBegin = 0; packetBegin < raysCount; packetBegin += RAYS_PACKET_SIZE) {
+		size_t packetSize = std::min(RAYS_PACKET_SIZE, raysCount - packetBegin);
+
+		raycastPacket(rays + packetBegin, packetSize, maxDistance, hits + packetBegin);
+	}
+}
+
+size_t TriangleMeshHierarchy::getTrianglesCount() const
+{
+	return m_triangles.size();
+}
+
+Triangle TriangleMeshHierarchy::getTriangle(size_t triangleIndex) const
+{
+	const std::vector<uint32>& trianglesIndices = m_hierarchy->getItemsIndices();
+	size_t preparedTriangleIndex = std::find(trianglesIndices.begin(), trianglesIndices.end(), triangleIndex) - trianglesIndices.begin();
+
+	const PreparedTriangle& triangle = m_triangles[preparedTriangleIndex];
+
+	return Triangle(triangle.vertex, triangle.vertex + triangle.edge1, triangle.vertex + triangle.edge2);
+}
+
+void TriangleMeshHierarchy::raycastPacket(const Ray * rays, size_t raysCount, float maxDistance, RaycastHit * hits) const
+{
+	_assert(raysCount <= RAYS_PACKET_SIZE);
+
+	RaysPacket packet;
+
+	for (size_t rayIndex = 0; rayIndex < RAYS_PACKET_SIZE; rayIndex++) {
+		bool isUsed = rayIndex < raysCount;
+
+		vector3 origin = isUsed ? rays[rayIndex].getOrigin() : vector3(0.0f);
+		vector3 direction = isUsed ? rays[rayIndex].getDirection() : vector3(1.0f, 0.0f, 0.0f);
+
+		packet.originX[rayIndex] = origin.x;
+		packet.originY[rayIndex] = origin.y;
+		packet.originZ[rayIndex] = origin.z;
+
+		packet.directionX[rayIndex] = direction.x;
+		packet.directionY[rayIndex] = direction.y;
+		packet.directionZ[rayIndex] = direction.z;
+
+		packet.inverseDirectionX[rayIndex] = 1.0f / direction.x;
+		packet.inverseDirectionY[rayIndex] = 1.0f / direction.y;
+		packet.inverseDirectionZ[rayIndex] = 1.0f / direction.z;
+
+		packet.maxDistance[rayIndex] = isUsed ? maxDistance : -1.0f;
+		packet.triangleIndex[rayIndex] = -1;
+	}
+
+	const std::vector<BoundingVolumeHierarchy::Node>& nodes = m_hierarchy->getNodes();
+	const std::vector<uint32>& trianglesIndices = m_hierarchy->getItemsIndices();
+
+	// The median split keeps the hierarchy depth logarithmic
+	const size_t MAX_TRAVERSAL_DEPTH = 64;
+
+	uint32 stack[MAX_TRAVERSAL_DEPTH];
+	size_t stackSize = 0;
+
+	if (!nodes.empty())
+		stack[stackSize++] = 0;
+
+	while (stackSize > 0) {
+		uint32 nodeIndex = stack[--stackSize];
+		const BoundingVolumeHierarchy::Node& node = nodes[nodeIndex];
+
+		if (intersectBounds(packet, node.bounds) == 0)
+			continue;
+
+		if (node.itemsCount > 0) {
+			for (size_t i = node.firstItemIndex; i < node.firstItemIndex + node.itemsCount; i++)
+				intersectTriangle(packet, m_triangles[i], trianglesIndices[i]);
+
+			continue;
+		}
+
+		_assert(stackSize + 2 <= MAX_TRAVERSAL_DEPTH);
+
+		stack[stackSize++] = node.secondChildIndex;
+		stack[stackSize++] = nodeIndex + 1;
+	}
+
+	for (size_t rayIndex = 0; rayIndex < raysCount; rayIndex++) {
+		hits[rayIndex].isHit = packet.triangleIndex[rayIndex] >= 0;
+		hits[rayIndex].distance = packet.maxDistance[rayIndex];
+		hits[rayIndex].triangleIndex = (size_t)packet.triangleIndex[rayIndex];
+	}
+}
+
+int TriangleMeshHierarchy::intersectBounds(const RaysPacket & packet, const AABB & bounds)
+{
+	vector3 min = bounds.getMin();
+	vector3 max = bounds.getMax();
+
+#ifdef TRIANGLE_MESH_HIERARCHY_SSE_ENABLED
+	__m128 originX = _mm_load_ps(packet.originX);
+	__m128 originY = _mm_load_ps(packet.originY);
+	__m128 originZ = _mm_load_ps(packet.originZ);
+
+	__m128 inverseDirectionX = _mm_load_ps(packet.inverseDirectionX);
+	__m128 inverseDirectionY = _mm_load_ps(packet.inverseDirectionY);
+	__m128 inverseDirectionZ = _mm_load_ps(packet.inverseDirectionZ);
+
+	__m128 t0x = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(min.x), originX), inverseDirectionX);
+	__m128 t1x = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(max.x), originX), inverseDirectionX);
+	__m128 t0y = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(min.y), originY), inverseDirectionY);
+	__m128 t1y = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(max.y), originY), inverseDirectionY);
+	__m128 t0z = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(min.z), originZ), inverseDirectionZ);
+	__m128 t1z = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(max.z), originZ), inverseDirectionZ);
+
+	__m128 tMinX, tMaxX, tMinY, tMaxY, tMinZ, tMaxZ;
+
+	getSlabDistances(t0x, t1x, tMinX, tMaxX);
+	getSlabDistances(t0y, t1y, tMinY, tMaxY);
+	getSlabDistances(t0z, t1z, tMinZ, tMaxZ);
+
+	__m128 tNear = _mm_max_ps(_mm_max_ps(tMinX, tMinY), _mm_max_ps(tMinZ, _mm_setzero_ps()));
+	__m128 tFar = _mm_min_ps(_mm_min_ps(tMaxX, tMaxY), _mm_min_ps(tMaxZ, _mm_load_ps(packet.maxDistance)));
+
+	return _mm_movemask_ps(_mm_cmple_ps(tNear, tFar));
+#else
+	int mask = 0;
+
+	for (size_t rayIndex = 0; rayIndex < RAYS_PACKET_SIZE; rayIndex++) {
+		vector3 origin(packet.originX[rayIndex], packet.originY[rayIndex], packet.originZ[rayIndex]);
+		vector3 inverseDirection(packet.inverseDirectionX[rayIndex], packet.inverseDirectionY[rayIndex], packet.inverseDirectionZ[rayIndex]);
+
+		vector3 t0 = (min - origin) * inverseDirection;
+		vector3 t1 = (max - origin) * inverseDirection;
+
+		vector3 tMin, tMax;
+
+		getSlabDistances(t0.x, t1.x, tMin.x, tMax.x);
+		getSlabDistances(t0.y, t1.y, tMin.y, tMax.y);
+		getSlabDistances(t0.z, t1.z, tMin.z, tMax.z);
+
+		float tNear = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+		float tFar = std::min(std::min(tMax.x, tMax.y), std::min(tMax.z, packet.maxDistance[rayIndex]));
+
+		if (tNear <= tFar)
+			mask |= 1 << rayIndex;
+	}
+
+	return mask;
+#endif
+}
+
+void TriangleMeshHierarchy::intersectTriangle(RaysPacket & packet, const PreparedTriangle & triangle, uint32 triangleIndex)
+{
+#ifdef TRIANGLE_MESH_HIERARCHY_SSE_ENABLED
+	// Moller-Trumbore test of one triangle against all the rays of the packet
+	__m128 directionX = _mm_load_ps(packet.directionX);
+	__m128 directionY = _mm_load_ps(packet.directionY);
+	__m128 directionZ = _mm_load_ps(packet.directionZ);
+
+	__m128 edge1X = _mm_set1_ps(triangle.edge1.x);
+	__m128 edge1Y = _mm_set1_ps(triangle.edge1.y);
+	__m128 edge1Z = _mm_set1_ps(triangle.edge1.z);
+
+	__m128 edge2X = _mm_set1_ps(triangle.edge2.x);
+	__m128 edge2Y = _mm_set1_ps(triangle.edge2.y);
+	__m128 edge2Z = _mm_set1_ps(triangle.edge2.z);
+
+	// h = direction x edge2
+	__m128 hX = _mm_sub_ps(_mm_mul_ps(directionY, edge2Z), _mm_mul_ps(directionZ, edge2Y));
+	__m128 hY = _mm_sub_ps(_mm_mul_ps(directionZ, edge2X), _mm_mul_ps(directionX, edge2Z));
+	__m128 hZ = _mm_sub_ps(_mm_mul_ps(directionX, edge2Y), _mm_mul_ps(directionY, edge2X));
+
+	__m128 a = _mm_add_ps(_mm_add_ps(_mm_mul_ps(edge1X, hX), _mm_mul_ps(edge1Y, hY)), _mm_mul_ps(edge1Z, hZ));
+	__m128 f = _mm_div_ps(_mm_set1_ps(1.0f), a);
+
+	__m128 sX = _mm_sub_ps(_mm_load_ps(packet.originX), _mm_set1_ps(triangle.vertex.x));
+	__m128 sY = _mm_sub_ps(_mm_load_ps(packet.originY), _mm_set1_ps(triangle.vertex.y));
+	__m128 sZ = _mm_sub_ps(_mm_load_ps(packet.originZ), _mm_set1_ps(triangle.vertex.z));
+
+	__m128 u = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(sX, hX), _mm_mul_ps(sY, hY)), _mm_mul_ps(sZ, hZ)));
+
+	// q = s x edge1
+	__m128 qX = _mm_sub_ps(_mm_mul_ps(sY, edge1Z), _mm_mul_ps(sZ, edge1Y));
+	__m128 qY = _mm_sub_ps(_mm_mul_ps(sZ, edge1X), _mm_mul_ps(sX, edge1Z));
+	__m128 qZ = _mm_sub_ps(_mm_mul_ps(sX, edge1Y), _mm_mul_ps(sY, edge1X));
+
+	__m128 v = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(directionX, qX), _mm_mul_ps(directionY, qY)), _mm_mul_ps(directionZ, qZ)));
+	__m128 t = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(edge2X, qX), _mm_mul_ps(edge2Y, qY)), _mm_mul_ps(edge2Z, qZ)));
+
+	__m128 zero = _mm_setzero_ps();
+	__m128 one = _mm_set1_ps(1.0f);
+	__m128 epsilon = _mm_set1_ps(RAY_TRIANGLE_EPSILON);
+
+	__m128 maxDistance = _mm_load_ps(packet.maxDistance);
+
+	__m128 hitMask = _mm_cmpgt_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), a), epsilon);
+	hitMask = _mm_and_ps(hitMask, _mm_cmpge_ps(u, zero));
+	hitMask = _mm_and_ps(hitMask, _mm_cmple_ps(u, one));
+	hitMask = _mm_and_ps(hitMask, _mm_cmpge_ps(v, zero));
+	hitMask = _mm_and_ps(hitMask, _mm_cmple_ps(_mm_add_ps(u, v), one));
+	hitMask = _mm_and_ps(hitMask, _mm_cmpgt_ps(t, epsilon));
+	hitMask = _mm_and_ps(hitMask, _mm_cmplt_ps(t, maxDistance));
+
+	int hitLanes = _mm_movemask_ps(hitMask);
+
+	if (hitLanes == 0)
+		return;
+
+	_mm_store_ps(packet.maxDistance, _mm_or_ps(_mm_and_ps(hitMask, t), _mm_andnot_ps(hitMask, maxDistance)));
+
+	for (size_t rayIndex = 0; rayIndex < RAYS_PACKET_SIZE; rayIndex++) {
+		if (hitLanes & (1 << rayIndex))
+			packet.triangleIndex[rayIndex] = triangleIndex;
+	}
+#else
+	for (size_t rayIndex = 0; rayIndex < RAYS_PACKET_SIZE; rayIndex++) {
+		vector3 origin(packet.originX[rayIndex], packet.originY[rayIndex], packet.originZ[rayIndex]);
+		vector3 direction(packet.directionX[rayIndex], packet.directionY[rayIndex], packet.directionZ[rayIndex]);
+
+		vector3 h = glm::cross(direction, triangle.edge2);
+		float a = glm::dot(triangle.edge1, h);
+
+		if (a > -RAY_TRIANGLE_EPSILON && a < RAY_TRIANGLE_EPSILON)
+			continue;
+
+		float f = 1.0f / a;
+		vector3 s = origin - triangle.vertex;
+		float u = f * glm::dot(s, h);
+
+		if (u < 0.0f || u > 1.0f)
+			continue;
+
+		vector3 q = glm::cross(s, triangle.edge1);
+		float v = f * glm::dot(direction, q);
+
+		if (v < 0.0f || u + v > 1.0f)
+			continue;
+
+		float t = f * glm::dot(triangle.edge2, q);
+
+		if (t > RAY_TRIANGLE_EPSILON && t < packet.maxDistance[rayIndex]) {
+			packet.maxDistance[rayIndex] = t;
+			packet.triangleIndex[rayIndex] = triangleIndex;
+		}
+	}
+#endif
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Engine/types.h>
+#include <Engine/Components/Math/types.h>
+#include <Engine/Components/Math/Geometry/Surfaces/Triangle.h>
+#include <Engine/Components/Physics/Ray.h>
+#include <Engine/Components/Physics/Broadphase/BoundingVolumeHierarchy.h>
+
+#include <vector>
+
+struct RaycastHit {
+	bool isHit;
+	float distance;
+
+	// Index of the triangle in the order of the mesh indices
+	size_t triangleIndex;
+};
+
+// Bounding volume hierarchy over the triangles of a static mesh for the nearest hit ray queries.
+// Rays are traced in packets of RAYS_PACKET_SIZE, a box or a triangle is tested against the whole packet at once.
+// Packets of nearby rays share the traversal, scattered rays gain little over the single queries
+class TriangleMeshHierarchy {
+public:
+	TriangleMeshHierarchy(const std::vector<vector3>& positions, const std::vector<uint32>& indices);
+	~TriangleMeshHierarchy();
+
+	bool raycast(const Ray& ray, float maxDistance, RaycastHit& hit) const;
+
+	// Ray directions don't have to be coherent, but coherent rays share more of the traversal
+	void raycast(const Ray* rays, size_t raysCount, float maxDistance, RaycastHit* hits) const;
+
+	size_t getTrianglesCount() const;
+	Triangle getTriangle(size_t triangleIndex) const;
+
+public:
+	static const size_t RAYS_PACKET_SIZE = 4;
+
+private:
+	struct PreparedTriangle {
+		vector3 vertex;
+		vector3 edge1;
+		vector3 edge2;
+	};
+
+	// Rays of a packet in the structure of arrays layout
+	struct RaysPacket;
+
+private:
+	void raycastPacket(const Ray* rays, size_t raysCount, float maxDistance, RaycastHit* hits) const;
+
+	// Returns the mask of the packet rays that pass through the box closer than their current hits
+	static int intersectBounds(const RaysPacket& packet, const AABB& bounds);
+	static void intersectTriangle(RaysPacket& packet, const PreparedTriangle& triangle, uint32 triangleIndex);
+
+private:
+	BoundingVolumeHierarchy* m_hierarchy;
+
+	// Triangles in the order of the hierarchy leaves
+	std::vector<PreparedTriangle> m_triangles;
+};
@@ -16,6 +16,10 @@ void Scene::onRegister(SceneId id) {
 	m_id = id;
 }
 
+void Scene::prepareRendering(float interpolationFactor)
+{
+}
+
 void Scene::activate()
 {
 }
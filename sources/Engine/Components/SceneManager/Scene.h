@@ -20,6 +20,9 @@ public:
 
 	void onRegister(SceneId id);
 
+	// Copies the state read by render, the update may run on another thread during the rendering.
+	// Interpolation factor is the part of the fixed update step passed since the last update
+	virtual void prepareRendering(float interpolationFactor);
 	virtual void render() = 0;
 	virtual void update() = 0;
 
@@ -17,6 +17,12 @@ void SceneManager::update()
 		m_activeScene->update();
 }
 
+void SceneManager::prepareRendering(float interpolationFactor)
+{
+	if (m_activeScene != nullptr)
+		m_activeScene->prepareRendering(interpolationFactor);
+}
+
 void SceneManager::render()
 {
 	if (m_activeScene != nullptr)
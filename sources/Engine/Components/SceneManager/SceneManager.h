@@ -14,6 +14,7 @@ public:
 	virtual ~SceneManager();
 
 	virtual void update();
+	virtual void prepareRendering(float interpolationFactor);
 	virtual void render();
 
 	SceneId registerScene(Scene* scene);
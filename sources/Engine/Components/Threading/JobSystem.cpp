@@ -0,0 +1,313 @@
+#include "JobSystem.h"
+
+#include <Engine\assertions.h>
+
+#include <algorithm>
+
+// System and queue of the current thread, the threads of other systems and the external ones have no queue
+static thread_local JobSystem* s_currentJobSystem = nullptr;
+static thread_local size_t s_currentQueueIndex = 0;
+
+JobCounter::JobCounter()
+	: m_unfinishedJobsCount(0)
+{
+}
+
+JobCounter::~JobCounter()
+{
+}
+
+bool JobCounter::isDone()
+{
+	if (m_unfinishedJobsCount.load() != 0)
+		return false;
+
+	// The last job may still be releasing the counter
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return true;
+}
+
+JobSystem::JobSystem(size_t workersCount)
+	: m_mainThreadId(std::this_thread::get_id()),
+	m_nextExternalQueueIndex(0),
+	m_queuedJobsCount(0),
+	m_isStopped(false)
+{
+	m_queues.reserve(workersCount + 1);
+
+	for (size_t queueIndex = 0; queueIndex < workersCount + 1; queueIndex++)
+		m_queues.push_back(new WorkerQueue());
+
+	s_currentJobSystem = this;
+	s_currentQueueIndex = 0;
+
+	m_workers.reserve(workersCount);
+
+	for (size_t workerIndex = 0; workerIndex < workersCount; workerIndex++)
+		m_workers.push_back(std::thread(&JobSystem::workerLoop, this, workerIndex + 1));
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_isStopped = true;
+	}
+
+	m_jobAvailableCondition.notify_all();
+
+	for (std::thread& worker : m_workers)
+		worker.join();
+
+	for (WorkerQueue* queue : m_queues)
+		delete queue;
+
+	if (s_currentJobSystem == this)
+		s_currentJobSystem = nullptr;
+}
+
+void JobSystem::schedule(const std::function<void()>& task, JobCounter* counter, JobCounter* dependency)
+{
+	if (counter != nullptr)
+		counter->m_unfinishedJobsCount++;
+
+	Job job = { task, counter };
+
+	if (dependency != nullptr) {
+		std::lock_guard<std::mutex> lock(dependency->m_mutex);
+
+		// The job is pushed by the last job of the dependency
+		if (dependency->m_unfinishedJobsCount.load() != 0) {
+			dependency->m_dependentJobs.push_back(std::move(job));
+			return;
+		}
+	}
+
+	pushJob(std::move(job));
+}
+
+void JobSystem::wait(JobCounter* counter)
+{
+	while (!counter->isDone()) {
+		if (runNextJob())
+			continue;
+
+		// The awaited jobs may need the main thread
+		if (isMainThread())
+			processMainThreadJobs();
+
+		std::this_thread::yield();
+	}
+}
+
+void JobSystem::parallelFor(size_t count, size_t batchSize, const RangeTask& task)
+{
+	if (count == 0)
+		return;
+
+	batchSize = std::max<size_t>(batchSize, 1);
+
+	// There is nothing to share, so don't wake up the workers
+	if (m_workers.empty() || count <= batchSize) {
+		task(0, count);
+		return;
+	}
+
+	JobCounter counter;
+
+	for (size_t begin = 0; begin < count; begin += batchSize) {
+		size_t end = std::min(begin + batchSize, count);
+
+		schedule([&task, begin, end]() { task(begin, end); }, &counter);
+	}
+
+	wait(&counter);
+}
+
+void JobSystem::scheduleOnMainThread(const std::function<void()>& task, JobCounter* counter)
+{
+	if (counter != nullptr)
+		counter->m_unfinishedJobsCount++;
+
+	std::lock_guard<std::mutex> lock(m_mainThreadJobsMutex);
+	m_mainThreadJobs.push_back({ task, counter });
+}
+
+void JobSystem::processMainThreadJobs()
+{
+	_assert(isMainThread());
+
+	std::vector<Job> jobs;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mainThreadJobsMutex);
+		jobs.swap(m_mainThreadJobs);
+	}
+
+	for (Job& job : jobs)
+		executeJob(job);
+}
+
+void JobSystem::runOnMainThread(const std::function<void()>& task)
+{
+	if (isMainThread())
+		task();
+	else
+		scheduleOnMainThread(task);
+}
+
+bool JobSystem::isMainThread() const
+{
+	return std::this_thread::get_id() == m_mainThreadId;
+}
+
+size_t JobSystem::getWorkersCount() const
+{
+	return m_workers.size();
+}
+
+size_t JobSystem::getDefaultWorkersCount()
+{
+	size_t hardwareThreadsCount = std::thread::hardware_concurrency();
+
+	// The main thread takes part in the jobs too
+	return (hardwareThreadsCount > 1) ? hardwareThreadsCount - 1 : 0;
+}
+
+void JobSystem::workerLoop(size_t queueIndex)
+{
+	s_currentJobSystem = this;
+	s_currentQueueIndex = queueIndex;
+
+	while (true) {
+		Job job;
+
+		if (takeJob(queueIndex, job)) {
+			executeJob(job);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		m_jobAvailableCondition.wait(lock, [this]() {
+			return m_isStopped || m_queuedJobsCount.load() != 0;
+		});
+
+		if (m_isStopped)
+			return;
+	}
+}
+
+void JobSystem::pushJob(Job&& job)
+{
+	size_t queueIndex = getCurrentQueueIndex();
+
+	if (queueIndex == EXTERNAL_THREAD_QUEUE)
+		queueIndex = m_nextExternalQueueIndex.fetch_add(1) % m_queues.size();
+
+	{
+		std::lock_guard<std::mutex> lock(m_queues[queueIndex]->mutex);
+		m_queues[queueIndex]->jobs.push_back(std::move(job));
+	}
+
+	m_queuedJobsCount++;
+
+	// Sleeping workers check the count under the lock, so the notification can't be lost
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+	}
+
+	m_jobAvailableCondition.notify_one();
+}
+
+bool JobSystem::takeJob(size_t queueIndex, Job& job)
+{
+	if (m_queuedJobsCount.load() == 0)
+		return false;
+
+	// The newest own job has the warmest data
+	if (queueIndex != EXTERNAL_THREAD_QUEUE) {
+		WorkerQueue* queue = m_queues[queueIndex];
+		std::lock_guard<std::mutex> lock(queue->mutex);
+
+		if (!queue->jobs.empty()) {
+			job = std::move(queue->jobs.back());
+			queue->jobs.pop_back();
+			m_queuedJobsCount--;
+
+			return true;
+		}
+	}
+
+	// The oldest jobs of the others are stolen, they usually spawn the most work
+	size_t queuesCount = m_queues.size();
+	size_t firstVictimIndex = (queueIndex == EXTERNAL_THREAD_QUEUE) ? 0 : queueIndex + 1;
+
+	for (size_t offset = 0; offset < queuesCount; offset++) {
+		size_t victimIndex = (firstVictimIndex + offset) % queuesCount;
+
+		if (victimIndex == queueIndex)
+			continue;
+
+		WorkerQueue* queue = m_queues[victimIndex];
+		std::lock_guard<std::mutex> lock(queue->mutex);
+
+		if (!queue->jobs.empty()) {
+			job = std::move(queue->jobs.front());
+			queue->jobs.pop_front();
+			m_queuedJobsCount--;
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool JobSystem::runNextJob()
+{
+	Job job;
+
+	if (!takeJob(getCurrentQueueIndex(), job))
+		return false;
+
+	executeJob(job);
+
+	return true;
+}
+
+void JobSystem::executeJob(Job& job)
+{
+	job.task();
+
+	finishJob(job.counter);
+}
+
+void JobSystem::finishJob(JobCounter* counter)
+{
+	if (counter == nullptr)
+		return;
+
+	std::vector<Job> dependentJobs;
+
+	{
+		std::lock_guard<std::mutex> lock(counter->m_mutex);
+
+		if (counter->m_unfinishedJobsCount.load() == 1)
+			dependentJobs.swap(counter->m_dependentJobs);
+
+		counter->m_unfinishedJobsCount--;
+	}
+
+	// The counter may be destroyed already, the dependent jobs are kept locally
+	for (Job& job : dependentJobs)
+		pushJob(std::move(job));
+}
+
+size_t JobSystem::getCurrentQueueIndex() const
+{
+	if (s_currentJobSystem != this)
+		return EXTERNAL_THREAD_QUEUE;
+
+	return s_currentQueueIndex;
+}
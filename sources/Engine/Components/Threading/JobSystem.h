@@ -0,0 +1,120 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+class JobCounter;
+
+struct Job {
+	std::function<void()> task;
+
+	// Counter of the group the job belongs to, can be null
+	JobCounter* counter;
+};
+
+// Number of the unfinished jobs of a group. Jobs depending on the group are started when it reaches zero.
+// Counter shouldn't be reused until all of its jobs are done
+class JobCounter {
+public:
+	JobCounter();
+	~JobCounter();
+
+	bool isDone();
+
+private:
+	std::atomic<size_t> m_unfinishedJobsCount;
+
+	std::mutex m_mutex;
+	std::vector<Job> m_dependentJobs;
+
+private:
+	friend class JobSystem;
+};
+
+// Runs jobs on the worker threads. Every worker has its own deque: it takes its own jobs from the back
+// and steals the oldest jobs of the others from the front when it runs out of them.
+// The thread that creates the system is the main one, it takes part in the jobs while it waits for them
+// and runs the main thread jobs (graphics calls) when it asks for them
+class JobSystem {
+public:
+	// Processes items [begin, end) of the parallel task
+	using RangeTask = std::function<void(size_t, size_t)>;
+
+public:
+	JobSystem(size_t workersCount);
+	~JobSystem();
+
+	// The counter is increased immediately and decreased when the job is done.
+	// The job isn't started until the dependency counter reaches zero
+	void schedule(const std::function<void()>& task, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+
+	// Runs other jobs while the counter isn't zero
+	void wait(JobCounter* counter);
+
+	// Splits [0, count) into batches and processes them on the workers and the calling thread,
+	// returns when all batches are done
+	void parallelFor(size_t count, size_t batchSize, const RangeTask& task);
+
+	// The job is run by the main thread in the next processMainThreadJobs call
+	void scheduleOnMainThread(const std::function<void()>& task, JobCounter* counter = nullptr);
+	void processMainThreadJobs();
+
+	// Runs the task immediately when it is called from the main thread, otherwise schedules it there
+	void runOnMainThread(const std::function<void()>& task);
+
+	bool isMainThread() const;
+	size_t getWorkersCount() const;
+
+public:
+	static size_t getDefaultWorkersCount();
+
+private:
+	struct WorkerQueue {
+		std::mutex mutex;
+		std::deque<Job> jobs;
+	};
+
+private:
+	void workerLoop(size_t queueIndex);
+
+	void pushJob(Job&& job);
+
+	// Takes a job from the own queue or steals it from the others
+	bool takeJob(size_t queueIndex, Job& job);
+	bool runNextJob();
+
+	void executeJob(Job& job);
+	void finishJob(JobCounter* counter);
+
+	size_t getCurrentQueueIndex() const;
+
+private:
+	// Queue index of the threads that don't belong to the system
+	static const size_t EXTERNAL_THREAD_QUEUE = static_cast<size_t>(-1);
+
+private:
+	std::vector<std::thread> m_workers;
+
+	// The main thread queue is the first one
+	std::vector<WorkerQueue*> m_queues;
+
+	std::thread::id m_mainThreadId;
+
+	// Jobs pushed by the external threads are spread over the queues
+	std::atomic<size_t> m_nextExternalQueueIndex;
+
+	std::atomic<size_t> m_queuedJobsCount;
+
+	std::mutex m_sleepMutex;
+	std::condition_variable m_jobAvailableCondition;
+
+	bool m_isStopped;
+
+	std::mutex m_mainThreadJobsMutex;
+	std::vector<Job> m_mainThreadJobs;
+};
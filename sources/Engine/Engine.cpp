@@ -1,7 +1,16 @@
 #include "Engine.h"
 
+static JobSystem* s_jobSystem = nullptr;
+
 void InitializeEngine(Window* window) {
+	s_jobSystem = new JobSystem(JobSystem::getDefaultWorkersCount());
 }
 
 void ShutdownEngine() {
+	delete s_jobSystem;
+	s_jobSystem = nullptr;
+}
+
+JobSystem* GetJobSystem() {
+	return s_jobSystem;
 }
\ No newline at end of file
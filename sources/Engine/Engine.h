@@ -7,8 +7,13 @@
 #include <Engine\Components\ResourceManager\ResourceManager.h>
 #include <Engine\Components\InputManager\InputManager.h>
 #include <Engine\Components\SceneManager\SceneManager.h>
+#include <Engine\Components\Threading\JobSystem.h>
+#include <Engine\Components\Memory\FrameArena.h>
 #include <Engine\Utils\Utils.h>
 #include <Engine\assertions.h>
 
 void InitializeEngine(Window* window);
-void ShutdownEngine();
\ No newline at end of file
+void ShutdownEngine();
+
+// Shared by all engine subsystems, available between the initialization and the shutdown
+JobSystem* GetJobSystem();
\ No newline at end of file
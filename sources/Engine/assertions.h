@@ -1,3 +1,8 @@
 #pragma once
 
+// Tools and benchmarks are built by the other compilers too
+#if !defined(_MSC_VER)
+#define __debugbreak() __builtin_trap()
+#endif
+
 #define _assert(condition) if (!(condition)) __debugbreak();
\ No newline at end of file
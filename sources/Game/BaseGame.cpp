@@ -2,18 +2,19 @@
 
 #include <iostream>
 #include <experimental\filesystem>
-#include <Windows.h>
+#include <chrono>
+#include <cmath>
 #include "config.h"
 
 #include <Engine\Components\Math\Random.h>
-#include <Engine\Utils\time.h>
 
 BaseGame::BaseGame(const std::string& windowName, unsigned int width, unsigned int height)
 	: m_window(nullptr), 
 	m_inputMgr(nullptr),
 	m_sceneMgr(nullptr),
 	m_updateTime(0.0),
-	m_renderTime(0.0)
+	m_renderTime(0.0),
+	m_fullFrameTime(0.0)
 {
 	using std::experimental::filesystem::path;
 	using std::experimental::filesystem::current_path;
@@ -25,6 +26,7 @@ BaseGame::BaseGame(const std::string& windowName, unsigned int width, unsigned i
 	// Window
 	m_window = new Window(windowName, width, height, false);
 	m_window->setCursorType(CursorType::Hidden);
+	m_window->setVSyncEnabled(RENDERING_VSYNC_ENABLED);
 
 	// Engine
 	InitializeEngine(m_window);
@@ -49,43 +51,103 @@ BaseGame::~BaseGame() {
 void BaseGame::update() {
 }
 
+void BaseGame::processInput() {
+}
+
+void BaseGame::prepareRendering(float interpolationFactor) {
+}
+
 void BaseGame::render() {
 
 }
 
 void BaseGame::run() {
-	const int FRAMES_PER_SECOND = GAME_STATE_UPDATES_PER_SECOND;
-	const int SKIP_TICKS = 1000 / FRAMES_PER_SECOND;
+	using Clock = std::chrono::steady_clock;
+	using Seconds = std::chrono::duration<double>;
 
-	unsigned long nextTick = GetTickCount();
+	// The game state is updated with the fixed step, frames are rendered as often as possible
+	const double UPDATE_STEP_DURATION = 1.0 / GAME_STATE_UPDATES_PER_SECOND;
 
-	int sleepTime = 0;
+	JobSystem* jobSystem = GetJobSystem();
 
+	// Updates scheduled by the previous frame in the pipelined mode
+	JobCounter updatesCounter;
 
-	while (true) {
-		double frameStartTime = TimeUtils::getCurrentTime();
+	double accumulatedTime = 0.0;
+	Clock::time_point previousFrameStartTime = Clock::now();
 
-		if (m_window->shouldClose()) {
-			break;
-		}
+	while (!m_window->shouldClose()) {
+		Clock::time_point frameStartTime = Clock::now();
+
+		accumulatedTime += Seconds(frameStartTime - previousFrameStartTime).count();
+		previousFrameStartTime = frameStartTime;
+
+		// Input events and the render snapshot touch the game state, so the updates have to be finished
+		jobSystem->wait(&updatesCounter);
+
+		// Temporary data of the previous frame isn't used by anyone now
+		FrameArena::startNewFrame();
 
 		glfwPollEvents();
-		
-		double startTime = TimeUtils::getCurrentTime();
-		update();
-		m_updateTime = TimeUtils::getCurrentTime() - startTime;
 
-		startTime = TimeUtils::getCurrentTime();
-		render();
-		m_renderTime = TimeUtils::getCurrentTime() - startTime;
+		// Graphics calls requested by the updates
+		jobSystem->processMainThreadJobs();
+
+		int updatesCount = 0;
+
+		while (accumulatedTime >= UPDATE_STEP_DURATION && updatesCount < MAX_UPDATES_PER_FRAME) {
+			accumulatedTime -= UPDATE_STEP_DURATION;
+			updatesCount++;
+		}
+
+		// Updates are slower than the real time, so the game slows down instead of falling behind more and more
+		if (accumulatedTime >= UPDATE_STEP_DURATION)
+			accumulatedTime = std::fmod(accumulatedTime, UPDATE_STEP_DURATION);
+
+		float interpolationFactor = static_cast<float>(accumulatedTime / UPDATE_STEP_DURATION);
 
-		nextTick += SKIP_TICKS;
-		sleepTime = nextTick - GetTickCount();
+		Clock::time_point renderStartTime;
 
-		m_fullFrameTime = TimeUtils::getCurrentTime() - frameStartTime;
+		if (GAME_PIPELINED_UPDATES_ENABLED) {
+			renderStartTime = Clock::now();
 
-		if (sleepTime >= 0) {
-			Sleep(sleepTime);
+			// The frame shows the state of the previous updates while the new ones run on a worker thread
+			prepareRendering(interpolationFactor);
+
+			if (updatesCount > 0) {
+				processInput();
+
+				jobSystem->schedule([this, updatesCount]() {
+					Clock::time_point updateStartTime = Clock::now();
+
+					for (int updateIndex = 0; updateIndex < updatesCount; updateIndex++)
+						update();
+
+					m_updateTime = Seconds(Clock::now() - updateStartTime).count();
+				}, &updatesCounter);
+			}
 		}
+		else {
+			Clock::time_point updateStartTime = Clock::now();
+
+			for (int updateIndex = 0; updateIndex < updatesCount; updateIndex++) {
+				processInput();
+				update();
+			}
+
+			renderStartTime = Clock::now();
+			m_updateTime = Seconds(renderStartTime - updateStartTime).count();
+
+			prepareRendering(interpolationFactor);
+		}
+
+		render();
+
+		Clock::time_point frameEndTime = Clock::now();
+
+		m_renderTime = Seconds(frameEndTime - renderStartTime).count();
+		m_fullFrameTime = Seconds(frameEndTime - frameStartTime).count();
 	}
+
+	jobSystem->wait(&updatesCounter);
 }
\ No newline at end of file
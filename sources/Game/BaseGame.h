@@ -10,7 +10,15 @@ public:
 	virtual ~BaseGame();
 
 	virtual void run();
+
+	// Fixed step of the game state, runs on a worker thread in the pipelined mode
 	virtual void update();
+	// Window, input and GUI processing before the updates, always runs on the main thread
+	virtual void processInput();
+
+	// Copies the state read by render, no update runs during the call.
+	// Interpolation factor is the part of the update step passed since the last update
+	virtual void prepareRendering(float interpolationFactor);
 	virtual void render();
 
 protected:
@@ -1,6 +1,8 @@
 #include "ConsoleCommandsHandler.h"
 
 #include <Engine\Utils\files.h>
+#include <Engine\Utils\string.h>
+#include <Engine\Components\Memory\FrameArena.h>
 
 ConsoleCommandsHandler::ConsoleCommandsHandler(Console * console)
 	: m_console(console), m_guiConsoleWidget(nullptr)
@@ -11,6 +13,9 @@ ConsoleCommandsHandler::ConsoleCommandsHandler(Console * console)
 	m_console->registerCommandHandler("clear",
 		std::bind(&ConsoleCommandsHandler::clear, this, std::placeholders::_1, std::placeholders::_2));
 
+	m_console->registerCommandHandler("frame-memory",
+		std::bind(&ConsoleCommandsHandler::frameMemory, this, std::placeholders::_1, std::placeholders::_2));
+
 }
 
 ConsoleCommandsHandler::~ConsoleCommandsHandler()
@@ -36,3 +41,13 @@ void ConsoleCommandsHandler::clear(Console * console, const std::vector<std::str
 	if (m_guiConsoleWidget != nullptr)
 		m_guiConsoleWidget->clear();
 }
+
+void ConsoleCommandsHandler::frameMemory(Console * console, const std::vector<std::string>& args)
+{
+	const FrameArena& mainThreadArena = FrameArena::getThreadArena();
+
+	console->print(StringUtils::format("main thread: %zu KB peak, %zu KB capacity",
+		mainThreadArena.getHighWaterMark() / 1024, mainThreadArena.getCapacity() / 1024));
+
+	console->print(StringUtils::format("all threads: %zu KB peak", FrameArena::getPeakUsedSize() / 1024));
+}
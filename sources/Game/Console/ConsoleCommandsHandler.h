@@ -12,6 +12,7 @@ public:
 private:
 	void fileAvailable(Console* console, const std::vector<std::string>& args);
 	void clear(Console* console, const std::vector<std::string>& args);
+	void frameMemory(Console* console, const std::vector<std::string>& args);
 
 private:
 	Console* m_console;
@@ -63,15 +63,20 @@ Game::~Game() {
 }
 
 void Game::update() {
-	m_inputMgr->update();
-
 	if (!m_guiConsoleWidget->isVisible())
 		m_sceneMgr->update();
-	
+}
+
+void Game::processInput() {
+	m_inputMgr->update();
 	m_guiMgr->update();
 	m_window->update();
 }
 
+void Game::prepareRendering(float interpolationFactor) {
+	m_sceneMgr->prepareRendering(interpolationFactor);
+}
+
 void Game::render() {
 	m_graphicsContext->setClearColor(0.6f, 0.6f, 0.8f);
 	m_graphicsContext->clear(RenderTarget::CLEAR_COLOR | RenderTarget::CLEAR_DEPTH);
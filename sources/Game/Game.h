@@ -14,6 +14,9 @@ public:
 	~Game();
 
 	void update();
+	void processInput();
+
+	void prepareRendering(float interpolationFactor);
 	void render();
 
 private:
@@ -1,8 +1,8 @@
 #include "Book.h"
 
-Book::Book(SolidMesh * mesh, BaseMaterial * baseMaterial, Texture* icon,
+Book::Book(Transform* transform, SolidMesh * mesh, BaseMaterial * baseMaterial, Texture* icon,
 	const std::string& title, const std::string & text)
-	: SolidGameObject(mesh, baseMaterial),
+	: SolidGameObject(transform, mesh, baseMaterial),
 	InventoryObject(icon),
 	m_text(text)
 {
@@ -5,7 +5,7 @@
 
 class Book : public SolidGameObject, public InventoryObject {
 public:
-	Book(SolidMesh* mesh, BaseMaterial* baseMaterial, Texture* icon, const std::string& title, const std::string& text);
+	Book(Transform* transform, SolidMesh* mesh, BaseMaterial* baseMaterial, Texture* icon, const std::string& title, const std::string& text);
 	~Book();
 
 	const std::string& getText() const;
@@ -1,7 +1,7 @@
 #include "LockedDoor.h"
 
-LockedDoor::LockedDoor(SolidMesh * mesh, BaseMaterial * baseMaterial, TimeManager* timeManager)
-	: SolidGameObject(mesh, baseMaterial),
+LockedDoor::LockedDoor(Transform* transform, SolidMesh * mesh, BaseMaterial * baseMaterial, TimeManager* timeManager)
+	: SolidGameObject(transform, mesh, baseMaterial),
 	m_timeManager(timeManager),
 	m_isOpened(false),
 	m_openCallback(nullptr)
@@ -10,7 +10,7 @@ public:
 	using OpenCallback = std::function<void(LockedDoor*)>;
 
 public:
-	LockedDoor(SolidMesh* mesh, BaseMaterial* baseMaterial, TimeManager* timeManager);
+	LockedDoor(Transform* transform, SolidMesh* mesh, BaseMaterial* baseMaterial, TimeManager* timeManager);
 	virtual ~LockedDoor();
 
 	void open();
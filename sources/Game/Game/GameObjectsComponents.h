@@ -0,0 +1,36 @@
+#pragma once
+
+#include <Game\GameObject.h>
+#include <Game\Graphics\Renderable.h>
+#include <Game\Graphics\Light.h>
+#include <Engine\Components\Physics\Colliders\OBB.h>
+
+#include <vector>
+
+// Components of the game objects entities. They index the objects rather than hold their data:
+// the components refer to the objects, so the store and the scene find the objects of a kind without the casts
+
+struct GameObjectComponent {
+	GameObject* object;
+};
+
+struct TransformComponent {
+	Transform* transform;
+};
+
+struct MeshComponent {
+	Renderable* renderable;
+};
+
+struct LightComponent {
+	Light* light;
+};
+
+struct ColliderComponent {
+	const std::vector<OBB>* colliders;
+};
+
+// The object is indexed in the interactive objects grid at the position
+struct InteractiveComponent {
+	vector3 indexedPosition;
+};
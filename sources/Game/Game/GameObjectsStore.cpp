@@ -2,65 +2,125 @@
 
 #include <Engine\assertions.h>
 
+#include <algorithm>
+
 GameObjectsStore::GameObjectsStore()
 	: m_player(nullptr),
 	m_removeObjectCallback(nullptr),
-	m_relocateObjectCallback(nullptr)
+	m_relocateObjectCallback(nullptr),
+	m_interactiveObjectsGrid(2.0f)
 {
 }
 
 GameObjectsStore::~GameObjectsStore()
 {
-	for (GameObject* object : m_gameObjects)
-		delete object;
+	// The pools destroy all objects left in them, the transforms are released after the objects
+	for (auto& pool : m_objectsPools)
+		delete pool.second;
 }
 
 void GameObjectsStore::update()
 {
 	for (GameObject* object : m_removedObjects)
-		delete object;
+		destroyGameObject(object);
 
 	m_removedObjects.clear();
 }
 
+Transform * GameObjectsStore::createTransform()
+{
+	return m_transformsPool.create();
+}
+
+void GameObjectsStore::updateTransforms()
+{
+	FrameVector<Transform*> outdatedTransforms;
+
+	m_transformsPool.forEach([&outdatedTransforms](Transform* transform) {
+		if (transform->isWorldMatrixOutdated())
+			outdatedTransforms.push_back(transform);
+	});
+
+	std::sort(outdatedTransforms.begin(), outdatedTransforms.end(), [](const Transform* first, const Transform* second) {
+		return first->getDepth() < second->getDepth();
+	});
+
+	// The parent matrix is ready, so every transform takes one multiplication
+	for (Transform* transform : outdatedTransforms)
+		transform->getTransformationMatrix();
+}
+
 void GameObjectsStore::registerGameObject(GameObject * object)
 {
-	_assert(object->getGameObjectId() == 0);
+	_assert(object->getGameObjectId() == GameObject::Id());
 
-	object->setGameObjectId(m_gameObjects.size() + 1);
-	m_gameObjects.push_back(object);
+	object->setGameObjectId(m_gameObjects.insert(object));
 
 	if (object->isPlayer())
 		m_player = static_cast<Player*>(object);
 
+	updateInteractiveObjectsGrid(object);
+
 	if (m_registerObjectCallback != nullptr)
 		m_registerObjectCallback(object);
 }
 
 void GameObjectsStore::removeGameObject(GameObject * object) {
-	m_gameObjects.erase((m_gameObjects.begin() + (object->getGameObjectId() - 1)));
+	m_gameObjects.remove(object->getGameObjectId());
+
+	removeFromInteractiveObjectsGrid(object);
 
 	if (m_removeObjectCallback != nullptr)
 		m_removeObjectCallback(object);
 
+	object->resetGameObjectId();
 	m_removedObjects.push_back(object);
 }
 
 void GameObjectsStore::relocateObject(GameObject * object, GameObject::Location newLocation)
 {
-	_assert(object->getGameObjectId() != 0);
+	_assert(m_gameObjects.contains(object->getGameObjectId()));
 
 	GameObject::Location oldLocation = object->getGameObjectLocation();
 
 	object->setGameObjectLocation(newLocation);
+	updateInteractiveObjectsGrid(object);
 
 	if (m_relocateObjectCallback != nullptr)
 		m_relocateObjectCallback(object, oldLocation, newLocation);
 }
 
+void GameObjectsStore::updateInteractiveObjects()
+{
+	// Only the indexed objects have the interactive component, the others aren't visited
+	m_entityManager.forEach<GameObjectComponent, InteractiveComponent>(
+		[this](Entity entity, GameObjectComponent& gameObject, InteractiveComponent& interactive) {
+			vector3 position = gameObject.object->getPosition();
+
+			if (position == interactive.indexedPosition)
+				return;
+
+			interactive.indexedPosition = position;
+			m_interactiveObjectsGrid.update(gameObject.object, position);
+		});
+}
+
+void GameObjectsStore::findInteractiveObjects(const vector3 & position, const vector3 & direction, float distance, float angle,
+	FrameVector<GameObject*>& objects) const
+{
+	m_interactiveObjectsGrid.queryCone(position, direction, distance, angle, objects);
+}
+
+GameObject * GameObjectsStore::getGameObject(GameObject::Id id) const
+{
+	GameObject* const* object = m_gameObjects.get(id);
+
+	return (object != nullptr) ? *object : nullptr;
+}
+
 const std::vector<GameObject*>& GameObjectsStore::getObjects() const
 {
-	return m_gameObjects;
+	return m_gameObjects.getValues();
 }
 
 Player * GameObjectsStore::getPlayer() const
@@ -68,6 +128,11 @@ Player * GameObjectsStore::getPlayer() const
 	return m_player;
 }
 
+EntityManager * GameObjectsStore::getEntityManager()
+{
+	return &m_entityManager;
+}
+
 void GameObjectsStore::setRemoveObjectCallback(const RemoveObjectCallback & callback)
 {
 	m_removeObjectCallback = callback;
@@ -82,3 +147,49 @@ void GameObjectsStore::setRegisterObjectCallback(const RegisterObjectCallback &
 {
 	m_registerObjectCallback = callback;
 }
+
+void GameObjectsStore::destroyGameObject(GameObject * object)
+{
+	auto poolIt = m_objectsPools.find(std::type_index(typeid(*object)));
+
+	// The object wasn't created by the store
+	_assert(poolIt != m_objectsPools.end());
+
+	Transform* transform = object->getTransform();
+
+	m_entityManager.destroyEntity(object->getEntity());
+	poolIt->second->destroy(object);
+
+	if (transform != nullptr)
+		m_transformsPool.destroy(transform);
+}
+
+void GameObjectsStore::updateInteractiveObjectsGrid(GameObject * object)
+{
+	if (!object->isInteractive() || !object->isLocatedInWorld()) {
+		removeFromInteractiveObjectsGrid(object);
+		return;
+	}
+
+	// Entities of the indexed objects have the interactive component and the others don't
+	vector3 position = object->getPosition();
+	InteractiveComponent* interactive = m_entityManager.getComponent<InteractiveComponent>(object->getEntity());
+
+	if (interactive != nullptr) {
+		interactive->indexedPosition = position;
+		m_interactiveObjectsGrid.update(object, position);
+	}
+	else {
+		m_entityManager.addComponent(object->getEntity(), InteractiveComponent{ position });
+		m_interactiveObjectsGrid.insert(object, position);
+	}
+}
+
+void GameObjectsStore::removeFromInteractiveObjectsGrid(GameObject * object)
+{
+	if (!m_interactiveObjectsGrid.contains(object))
+		return;
+
+	m_interactiveObjectsGrid.remove(object);
+	m_entityManager.removeComponent<InteractiveComponent>(object->getEntity());
+}
@@ -2,8 +2,18 @@
 
 #include <Game\GameObject.h>
 #include <Game\Player.h>
+#include <Game\SolidGameObject.h>
+#include <Game\Game\GameObjectsComponents.h>
+#include <Engine\Components\Physics\Broadphase\SpatialHashGrid.h>
+#include <Engine\Components\Memory\FrameAllocator.h>
+#include <Engine\Components\Memory\ObjectsPool.h>
+#include <Engine\Components\Memory\SlotMap.h>
+#include <Engine\Components\ECS\EntityManager.h>
 
 #include <functional>
+#include <unordered_map>
+#include <typeindex>
+#include <type_traits>
 
 class GameObjectsStore {
 public:
@@ -17,24 +27,134 @@ public:
 
 	void update();
 
+	// Objects of every type are kept in their own pool, the store destroys them after the removal
+	template<class T, class... Args>
+	T* createGameObject(Args&&... args);
+
+	// Transforms of all objects are kept together, they are released with the objects
+	Transform* createTransform();
+
+	// Computes the outdated world matrices of the transforms, the parents go before their children
+	void updateTransforms();
+
 	void registerGameObject(GameObject* object);
 	void removeGameObject(GameObject* object);
 
 	void relocateObject(GameObject* object, GameObject::Location newLocation);
 
+	// Reindexes the interactive objects moved since the last call
+	void updateInteractiveObjects();
+
+	// Interactive objects in the world within the distance and the angle (in degrees) from the direction,
+	// sorted by the distance
+	void findInteractiveObjects(const vector3& position, const vector3& direction, float distance, float angle,
+		FrameVector<GameObject*>& objects) const;
+
+	// Returns null if the object was removed
+	GameObject* getGameObject(GameObject::Id id) const;
+
+	// Registered objects in no particular order
 	const std::vector<GameObject*>& getObjects() const;
 	Player* getPlayer() const;
 
+	EntityManager* getEntityManager();
+
 	void setRemoveObjectCallback(const RemoveObjectCallback& callback);
 	void setRelocateObjectCallback(const RelocateObjectCallback& callback);
 	void setRegisterObjectCallback(const RegisterObjectCallback& callback);
+
 protected:
-	std::vector<GameObject*> m_gameObjects;
+	class BaseGameObjectsPool {
+	public:
+		virtual ~BaseGameObjectsPool() {}
+
+		virtual void destroy(GameObject* object) = 0;
+	};
+
+	template<class T>
+	class GameObjectsPool : public BaseGameObjectsPool {
+	public:
+		virtual void destroy(GameObject* object) override;
+
+	public:
+		ObjectsPool<T> objects;
+	};
+
+protected:
+	template<class T>
+	ObjectsPool<T>& getObjectsPool();
+
+	// Components of the entity are chosen by the type of the object
+	template<class T>
+	void createGameObjectEntity(T* object);
+
+	void destroyGameObject(GameObject* object);
+
+	// Keeps the interactive objects of the world in the grid and the others out of it
+	void updateInteractiveObjectsGrid(GameObject* object);
+	void removeFromInteractiveObjectsGrid(GameObject* object);
+
+protected:
+	SlotMap<GameObject*> m_gameObjects;
 
 	std::list<GameObject*> m_removedObjects;
 
+	SpatialHashGrid<GameObject*> m_interactiveObjectsGrid;
+
+	// Pools are found by the dynamic type of the objects
+	std::unordered_map<std::type_index, BaseGameObjectsPool*> m_objectsPools;
+	ObjectsPool<Transform> m_transformsPool;
+
+	EntityManager m_entityManager;
+
 	Player* m_player;
 	RemoveObjectCallback m_removeObjectCallback;
 	RelocateObjectCallback m_relocateObjectCallback;
 	RegisterObjectCallback m_registerObjectCallback;
-};
\ No newline at end of file
+};
+
+template<class T, class... Args>
+inline T * GameObjectsStore::createGameObject(Args&&... args)
+{
+	T* object = getObjectsPool<T>().create(std::forward<Args>(args)...);
+	createGameObjectEntity(object);
+
+	return object;
+}
+
+template<class T>
+inline ObjectsPool<T>& GameObjectsStore::getObjectsPool()
+{
+	BaseGameObjectsPool*& pool = m_objectsPools[std::type_index(typeid(T))];
+
+	if (pool == nullptr)
+		pool = new GameObjectsPool<T>();
+
+	return static_cast<GameObjectsPool<T>*>(pool)->objects;
+}
+
+template<class T>
+inline void GameObjectsStore::createGameObjectEntity(T * object)
+{
+	Entity entity = m_entityManager.createEntity(GameObjectComponent{ object });
+
+	if (object->getTransform() != nullptr)
+		m_entityManager.addComponent(entity, TransformComponent{ object->getTransform() });
+
+	if constexpr (std::is_base_of_v<Renderable, T>)
+		m_entityManager.addComponent(entity, MeshComponent{ object });
+
+	if constexpr (std::is_base_of_v<Light, T>)
+		m_entityManager.addComponent(entity, LightComponent{ object });
+
+	if constexpr (std::is_base_of_v<SolidGameObject, T>)
+		m_entityManager.addComponent(entity, ColliderComponent{ &object->getColliders() });
+
+	object->setEntity(entity);
+}
+
+template<class T>
+inline void GameObjectsStore::GameObjectsPool<T>::destroy(GameObject * object)
+{
+	objects.destroy(static_cast<T*>(object));
+}
@@ -1,5 +1,7 @@
 #include "GameHUD.h"
 
+#include <Engine\Engine.h>
+
 GameHUD::GameHUD(GraphicsResourceFactory* graphicsResourceFactory,  Font* defaultFont, GUIManager * guiManager, GUILayout * guiLayout)
 	: m_guiManager(guiManager),
 	m_guiLayout(guiLayout),
@@ -48,47 +50,62 @@ void GameHUD::update()
 
 void GameHUD::setCurrentTaskInfo(const std::string & taskTitle, const std::string & objectiveTitle)
 {
-	m_currentTaskText->setText(taskTitle);
-	m_currentObjectiveText->setText(objectiveTitle);
+	// Texts are built with the graphics calls, so the widgets are changed on the main thread
+	GetJobSystem()->runOnMainThread([this, taskTitle, objectiveTitle]() {
+		m_currentTaskText->setText(taskTitle);
+		m_currentObjectiveText->setText(objectiveTitle);
 
-	m_isActiveTaskExists = true;
+		m_isActiveTaskExists = true;
+	});
 }
 
 void GameHUD::setNoActiveTask()
 {
-	m_currentTaskText->setText("  ");
-	m_currentObjectiveText->hide();
+	GetJobSystem()->runOnMainThread([this]() {
+		m_currentTaskText->setText("  ");
+		m_currentObjectiveText->hide();
 
-	m_isActiveTaskExists = false;
+		m_isActiveTaskExists = false;
+	});
 }
 
 void GameHUD::showTaskInfo()
 {
-	m_currentTaskText->show();
+	GetJobSystem()->runOnMainThread([this]() {
+		m_currentTaskText->show();
 
-	if (m_isActiveTaskExists)
-		m_currentObjectiveText->show();
+		if (m_isActiveTaskExists)
+			m_currentObjectiveText->show();
+	});
 }
 
 void GameHUD::hideTaskInfo()
 {
-	m_currentTaskText->hide();
-	m_currentObjectiveText->hide();
+	GetJobSystem()->runOnMainThread([this]() {
+		m_currentTaskText->hide();
+		m_currentObjectiveText->hide();
+	});
 }
 
 void GameHUD::setInteractiveObjectHint(const std::string & hint)
 {
-	m_interactiveHint->setText(hint);
+	GetJobSystem()->runOnMainThread([this, hint]() {
+		m_interactiveHint->setText(hint);
+	});
 }
 
 void GameHUD::showInteractiveObjectHint()
 {
-	m_interactiveHint->show();
+	GetJobSystem()->runOnMainThread([this]() {
+		m_interactiveHint->show();
+	});
 }
 
 void GameHUD::hideInteractiveObjectHint()
 {
-	m_interactiveHint->hide();
+	GetJobSystem()->runOnMainThread([this]() {
+		m_interactiveHint->hide();
+	});
 }
 
 void GameHUD::registerModalWindow(HUDWindow * window)
@@ -3,7 +3,8 @@
 #include <Engine\assertions.h>
 
 GameObject::GameObject()
-	: m_gameObjectId(0),
+	: m_gameObjectId(),
+	m_entity(),
 	m_gameObjectUsage(Usage::Dummy),
 	m_gameObjectLocation(Location::None),
 	m_gameObjectInteractiveMode(InteractiveMode::None),
@@ -24,14 +25,24 @@ GameObject::Id GameObject::getGameObjectId() const
 
 void GameObject::setGameObjectId(GameObject::Id id)
 {
-	_assert(m_gameObjectId == 0);
+	_assert(m_gameObjectId == Id());
 
 	m_gameObjectId = id;
 }
 
 void GameObject::resetGameObjectId()
 {
-	m_gameObjectId = 0;
+	m_gameObjectId = Id();
+}
+
+Entity GameObject::getEntity() const
+{
+	return m_entity;
+}
+
+void GameObject::setEntity(Entity entity)
+{
+	m_entity = entity;
 }
 
 GameObject::Usage GameObject::getGameObjectUsage() const
@@ -71,6 +82,11 @@ bool GameObject::isLocatedInWorld()
 	return m_gameObjectLocation == Location::World;
 }
 
+Transform * GameObject::getTransform() const
+{
+	return nullptr;
+}
+
 void GameObject::setGameObjectInteractiveMode(InteractiveMode mode)
 {
 	m_gameObjectInteractiveMode = mode;
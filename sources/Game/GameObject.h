@@ -3,12 +3,15 @@
 #include <Engine\Components\Graphics\RenderSystem\GpuProgram.h>
 #include <Engine\Components\Graphics\RenderSystem\GraphicsContext.h>
 #include <Engine\Components\Math\Transform.h>
+#include <Engine\Components\Memory\SlotMap.h>
+#include <Engine\Components\ECS\Archetype.h>
 
 #include <functional>
 
 class GameObject {
 public:
-	using Id = size_t;
+	// Handle of the object in the objects store, the default one means that the object isn't registered
+	using Id = SlotMapHandle;
 
 	enum class Usage {
 		Dummy, StaticEnvironmentObject, DynamicObject, LightSource, Player
@@ -33,6 +36,10 @@ public:
 	void setGameObjectId(Id id);
 	void resetGameObjectId();
 
+	// Entity describing the object for the systems, it is created by the objects store
+	Entity getEntity() const;
+	void setEntity(Entity entity);
+
 	Usage getGameObjectUsage() const;
 	void setGameObjectUsage(Usage usage);
 
@@ -46,6 +53,9 @@ public:
 
 	virtual vector3 getPosition() const = 0;
 
+	// Objects placed without a transform return null
+	virtual Transform* getTransform() const;
+
 	void setGameObjectInteractiveMode(InteractiveMode mode);
 	InteractiveMode getGameObjectInteractiveMode() const;
 
@@ -63,6 +73,7 @@ public:
 	void setTakeCallback(const ActionCallback& callback);
 protected:
 	Id m_gameObjectId;
+	Entity m_entity;
 	Usage m_gameObjectUsage;
 
 	Location m_gameObjectLocation;
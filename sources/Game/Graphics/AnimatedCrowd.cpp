@@ -0,0 +1,103 @@
+#include "AnimatedCrowd.h"
+
+#include <Engine\assertions.h>
+
+AnimatedCrowd::AnimatedCrowd(SolidMesh * mesh, BakedAnimation * animation, BaseMaterial * baseMaterial)
+	: Renderable(baseMaterial),
+	m_mesh(mesh),
+	m_animation(animation),
+	m_currentTime(0.0f),
+	m_renderedTime(0.0f)
+{
+	_assert(m_mesh->hasSkeleton() && m_mesh->getSkeleton()->getBonesCount() == m_animation->getBonesCount());
+}
+
+AnimatedCrowd::~AnimatedCrowd()
+{
+}
+
+void AnimatedCrowd::prepareRendering()
+{
+	m_renderedTime = m_currentTime;
+	m_renderedInstancesTransforms = m_instancesTransforms;
+	m_renderedInstancesTimeOffsets = m_instancesTimeOffsets;
+}
+
+void AnimatedCrowd::render()
+{
+	if (m_renderedInstancesTransforms.empty())
+		return;
+
+	GpuProgram* gpuProgram = m_baseMaterial->getGpuProgram();
+
+	m_animation->getBonesTexture()->bind(BONES_TEXTURE_UNIT);
+
+	gpuProgram->setParameter("bakedAnimation.bonesTexture", (int)BONES_TEXTURE_UNIT);
+	gpuProgram->setParameter("bakedAnimation.framesCount", (int)m_animation->getFramesCount());
+	gpuProgram->setParameter("bakedAnimation.framesPerSecond", m_animation->getFramesPerSecond());
+	gpuProgram->setParameter("bakedAnimation.isLooped", m_animation->isLooped());
+	gpuProgram->setParameter("bakedAnimation.time", m_renderedTime);
+
+	for (size_t batchBegin = 0; batchBegin < m_renderedInstancesTransforms.size(); batchBegin += MAX_INSTANCES_PER_DRAW) {
+		size_t batchSize = std::min(MAX_INSTANCES_PER_DRAW, m_renderedInstancesTransforms.size() - batchBegin);
+
+		gpuProgram->setParameter("instances.transforms[0]", &m_renderedInstancesTransforms[batchBegin], batchSize);
+		gpuProgram->setParameter("instances.timeOffsets[0]", &m_renderedInstancesTimeOffsets[batchBegin], batchSize);
+
+		m_mesh->renderInstanced(m_baseMaterial, batchSize);
+	}
+}
+
+size_t AnimatedCrowd::addInstance(const matrix4 & transform, float timeOffset)
+{
+	m_instancesTransforms.push_back(transform);
+	m_instancesTimeOffsets.push_back(timeOffset);
+
+	return m_instancesTransforms.size() - 1;
+}
+
+void AnimatedCrowd::removeInstance(size_t index)
+{
+	_assert(index < m_instancesTransforms.size());
+
+	// Order of instances doesn't matter, so the last one takes the free place
+	m_instancesTransforms[index] = m_instancesTransforms.back();
+	m_instancesTransforms.pop_back();
+
+	m_instancesTimeOffsets[index] = m_instancesTimeOffsets.back();
+	m_instancesTimeOffsets.pop_back();
+}
+
+void AnimatedCrowd::setInstanceTransform(size_t index, const matrix4 & transform)
+{
+	m_instancesTransforms[index] = transform;
+}
+
+const matrix4 & AnimatedCrowd::getInstanceTransform(size_t index) const
+{
+	return m_instancesTransforms[index];
+}
+
+void AnimatedCrowd::setInstanceTimeOffset(size_t index, float timeOffset)
+{
+	m_instancesTimeOffsets[index] = timeOffset;
+}
+
+float AnimatedCrowd::getInstanceTimeOffset(size_t index) const
+{
+	return m_instancesTimeOffsets[index];
+}
+
+size_t AnimatedCrowd::getInstancesCount() const
+{
+	return m_instancesTransforms.size();
+}
+
+void AnimatedCrowd::increaseAnimationTime(float delta)
+{
+	m_currentTime += delta;
+
+	// Keep the time small enough for float precision in the shader
+	if (m_animation->isLooped())
+		m_currentTime = fmod(m_currentTime, m_animation->getDuration());
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Game\Graphics\Renderable.h>
+#include <Game\Graphics\SolidMesh.h>
+#include <Game\Graphics\Animation\BakedAnimation.h>
+
+// Many instances of one skinned mesh playing the same baked animation with individual time offsets.
+// Instances are drawn in batches, the base material GPU program is expected to support baked skinning
+class AnimatedCrowd : public Renderable {
+public:
+	AnimatedCrowd(SolidMesh* mesh, BakedAnimation* animation, BaseMaterial* baseMaterial);
+	virtual ~AnimatedCrowd();
+
+	virtual void prepareRendering() override;
+	virtual void render() override;
+
+	size_t addInstance(const matrix4& transform, float timeOffset);
+	void removeInstance(size_t index);
+
+	void setInstanceTransform(size_t index, const matrix4& transform);
+	const matrix4& getInstanceTransform(size_t index) const;
+
+	void setInstanceTimeOffset(size_t index, float timeOffset);
+	float getInstanceTimeOffset(size_t index) const;
+
+	size_t getInstancesCount() const;
+
+	void increaseAnimationTime(float delta);
+
+public:
+	// Must match the size of the instances arrays in the GPU program
+	static const size_t MAX_INSTANCES_PER_DRAW = 32;
+
+	static const unsigned int BONES_TEXTURE_UNIT = 3;
+
+private:
+	SolidMesh* m_mesh;
+	BakedAnimation* m_animation;
+
+	// Crowd time, seconds
+	float m_currentTime;
+
+	std::vector<matrix4> m_instancesTransforms;
+	std::vector<float> m_instancesTimeOffsets;
+
+	// The instances are changed by the updates while the previous frame is rendered
+	float m_renderedTime;
+	std::vector<matrix4> m_renderedInstancesTransforms;
+	std::vector<float> m_renderedInstancesTimeOffsets;
+};
@@ -0,0 +1,74 @@
+#include "AnimationBaker.h"
+
+#include <Engine\assertions.h>
+
+AnimationBaker::AnimationBaker(GraphicsResourceFactory * graphicsResourceFactory)
+	: m_graphicsResourceFactory(graphicsResourceFactory)
+{
+}
+
+AnimationBaker::~AnimationBaker()
+{
+}
+
+BakedAnimation * AnimationBaker::bake(const Skeleton * skeleton, Animation * animation, float framesPerSecond)
+{
+	_assert(skeleton != nullptr && animation != nullptr && framesPerSecond > 0.0f);
+
+	float ticksPerSecond = animation->getSpeed() * animation->getSpeedFactor();
+	float ticksPerFrame = ticksPerSecond / framesPerSecond;
+
+	bool isLooped = animation->getEndBehaviour() == Animation::EndBehaviour::Repeat;
+
+	// Looped animations wrap to the first frame, the others need one more frame with the final pose
+	size_t framesCount = std::max<size_t>((size_t)std::ceil(animation->getDuration() / ticksPerFrame), 1);
+
+	if (!isLooped)
+		framesCount++;
+
+	size_t bonesCount = skeleton->getBonesCount();
+
+	size_t rowLength = bonesCount * BakedAnimation::TEXELS_PER_BONE;
+	std::vector<vector4> texels(rowLength * framesCount);
+
+	// The animator does all the sampling work, the baker only moves it through the frames
+	Animator animator(skeleton);
+	animator.setCurrentAnimation(animation);
+	animator.play();
+
+	for (size_t frameIndex = 0; frameIndex < framesCount; frameIndex++) {
+		// The time of the last frame is clamped to the duration by the animator
+		animator.setCurrentTime(frameIndex * ticksPerFrame);
+		animator.increaseAnimationTime(0.0f);
+
+		const std::vector<matrix4>& matrixPalette = animator.getMatrixPalette();
+		vector4* frameTexels = &texels[frameIndex * rowLength];
+
+		for (size_t boneIndex = 0; boneIndex < bonesCount; boneIndex++) {
+			// Skinning matrices are affine, the last row is always (0, 0, 0, 1)
+			matrix4 boneTransform = glm::transpose(matrixPalette[boneIndex]);
+
+			for (size_t rowIndex = 0; rowIndex < BakedAnimation::TEXELS_PER_BONE; rowIndex++)
+				frameTexels[boneIndex * BakedAnimation::TEXELS_PER_BONE + rowIndex] = boneTransform[rowIndex];
+		}
+	}
+
+	Texture* bonesTexture = m_graphicsResourceFactory->createTexture();
+
+	bonesTexture->setTarget(Texture::Target::_2D);
+	bonesTexture->setInternalFormat(Texture::InternalFormat::RGBA32F);
+	bonesTexture->setSize(rowLength, framesCount);
+	bonesTexture->create();
+
+	bonesTexture->bind();
+	bonesTexture->setData(Texture::PixelFormat::RGBA, Texture::PixelDataType::Float, (const std::byte*)texels.data());
+
+	// Frames are blended in the shader, the texture is only ever fetched by texel coordinates
+	bonesTexture->setMinificationFilter(Texture::Filter::Nearest);
+	bonesTexture->setMagnificationFilter(Texture::Filter::Nearest);
+	bonesTexture->setWrapMode(Texture::WrapMode::ClampToEdge);
+
+	bonesTexture->unbind();
+
+	return new BakedAnimation(bonesTexture, bonesCount, framesCount, framesPerSecond, isLooped);
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <Engine\Components\Graphics\GraphicsResourceFactory.h>
+
+#include "Animator.h"
+#include "BakedAnimation.h"
+
+// Samples skeletal animations into textures, so that crowds of the same mesh
+// can be skinned on GPU without per-instance animators
+class AnimationBaker {
+public:
+	AnimationBaker(GraphicsResourceFactory* graphicsResourceFactory);
+	~AnimationBaker();
+
+	BakedAnimation* bake(const Skeleton* skeleton, Animation* animation, float framesPerSecond);
+
+private:
+	GraphicsResourceFactory* m_graphicsResourceFactory;
+};
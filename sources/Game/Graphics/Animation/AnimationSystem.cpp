@@ -0,0 +1,71 @@
+#include "AnimationSystem.h"
+
+#include <algorithm>
+
+#include <Engine\assertions.h>
+#include <Engine\Components\Math\Geometry\Frustum.h>
+
+AnimationSystem::AnimationSystem(JobSystem* jobSystem)
+	: m_jobSystem(jobSystem),
+	m_viewer(nullptr)
+{
+}
+
+AnimationSystem::~AnimationSystem()
+{
+}
+
+void AnimationSystem::registerAnimator(Animator * animator)
+{
+	registerAnimator(animator, nullptr, 0.0f);
+}
+
+void AnimationSystem::registerAnimator(Animator * animator, const Transform * transform, float boundingRadius)
+{
+	_assert(std::find_if(m_animatedObjects.begin(), m_animatedObjects.end(), 
+		[animator](const AnimatedObject& object) { return object.animator == animator; }) == m_animatedObjects.end());
+
+	m_animatedObjects.push_back({ animator, transform, boundingRadius });
+}
+
+void AnimationSystem::removeAnimator(Animator * animator)
+{
+	m_animatedObjects.erase(std::remove_if(m_animatedObjects.begin(), m_animatedObjects.end(),
+		[animator](const AnimatedObject& object) { return object.animator == animator; }), m_animatedObjects.end());
+}
+
+void AnimationSystem::setViewer(const Camera * viewer)
+{
+	m_viewer = viewer;
+}
+
+const Camera * AnimationSystem::getViewer() const
+{
+	return m_viewer;
+}
+
+void AnimationSystem::update(float delta)
+{
+	Frustum viewFrustum;
+	vector3 viewerPosition;
+
+	if (m_viewer != nullptr) {
+		viewFrustum.setViewProjectionTransform(m_viewer->getProjectionMatrix() * m_viewer->getViewMatrix());
+		viewerPosition = m_viewer->getTransform()->getPosition();
+	}
+
+	m_jobSystem->parallelFor(m_animatedObjects.size(), ANIMATORS_BATCH_SIZE, [&](size_t begin, size_t end) {
+		for (size_t objectIndex = begin; objectIndex < end; objectIndex++) {
+			const AnimatedObject& object = m_animatedObjects[objectIndex];
+
+			if (object.transform != nullptr && m_viewer != nullptr) {
+				vector3 position = object.transform->getPosition();
+
+				object.animator->updateLevelOfDetail(glm::distance(position, viewerPosition),
+					viewFrustum.isSphereIntersecting(position, object.boundingRadius));
+			}
+
+			object.animator->increaseAnimationTime(delta);
+		}
+	});
+}
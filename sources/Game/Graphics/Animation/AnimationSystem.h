@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+
+#include <Engine\Components\Threading\JobSystem.h>
+#include <Engine\Components\Graphics\RenderSystem\Camera.h>
+#include <Engine\Components\Math\Transform.h>
+
+#include "Animator.h"
+
+// Advances all registered animators every tick. Animators don't share any mutable state
+// (skeletons and animations are read-only), so sampling and palette building are spread across the workers.
+class AnimationSystem {
+public:
+	AnimationSystem(JobSystem* jobSystem);
+	~AnimationSystem();
+
+	// Animator is always updated with the full level of detail
+	void registerAnimator(Animator* animator);
+
+	// Level of detail of the animator is selected by the distance from the viewer 
+	// to the transform and by the visibility of the bounding sphere
+	void registerAnimator(Animator* animator, const Transform* transform, float boundingRadius);
+
+	void removeAnimator(Animator* animator);
+
+	void setViewer(const Camera* viewer);
+	const Camera* getViewer() const;
+
+	void update(float delta);
+
+private:
+	struct AnimatedObject {
+		Animator* animator;
+		const Transform* transform;
+		float boundingRadius;
+	};
+
+	static const size_t ANIMATORS_BATCH_SIZE = 4;
+
+private:
+	JobSystem* m_jobSystem;
+	const Camera* m_viewer;
+
+	std::vector<AnimatedObject> m_animatedObjects;
+};
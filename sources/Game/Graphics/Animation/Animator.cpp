@@ -2,12 +2,19 @@
 
 #include <Engine\assertions.h>
 
-Animator::Animator(Skeleton* skeleton)
+Animator::Animator(const Skeleton* skeleton)
 	: m_currentAnimation(nullptr), 
 	m_skeleton(skeleton), 
 	m_currentTime(0.0f), 
 	m_currentPose(skeleton->getBonesCount()),
-	m_currentAnimationState(AnimationState::Stopped)
+	m_matrixPalette(skeleton->getBonesCount(), matrix4(1.0f)),
+	m_currentAnimationState(AnimationState::Stopped),
+	m_levelOfDetail(LevelOfDetail::Full),
+	m_sourceMatrixPalette(skeleton->getBonesCount(), matrix4(1.0f)),
+	m_targetMatrixPalette(skeleton->getBonesCount(), matrix4(1.0f)),
+	m_interpolationStep(0),
+	m_interpolationStepsCount(0),
+	m_isMatrixPaletteOutdated(true)
 {
 
 }
@@ -20,6 +27,8 @@ void Animator::setCurrentAnimation(Animation * animation)
 {
 	m_currentAnimation = animation;
 	m_currentTime = 0.0f;
+
+	m_isMatrixPaletteOutdated = true;
 }
 
 Animation * Animator::getCurrentAnimation()
@@ -41,17 +50,96 @@ void Animator::increaseAnimationTime(float delta)
 		else {
 			m_currentTime = 0.0f;
 			m_currentAnimationState = AnimationState::Stopped;
+
+			// Final pose must be exact even if the animator is interpolating
+			m_isMatrixPaletteOutdated = true;
 		}
 	}
 
-	updatePose();
+	if (m_levelOfDetail == LevelOfDetail::Paused)
+		return;
+
+	size_t updateInterval = getUpdateInterval();
+
+	if (updateInterval <= 1 || m_isMatrixPaletteOutdated)
+		updatePose();
+	else
+		updateInterpolatedPose(delta, updateInterval);
+}
+
+void Animator::setCurrentTime(float time)
+{
+	_assert(m_currentAnimation != nullptr);
+
+	m_currentTime = glm::clamp(time, 0.0f, m_currentAnimation->getDuration());
+	m_isMatrixPaletteOutdated = true;
+}
+
+float Animator::getCurrentTime() const
+{
+	return m_currentTime;
 }
 
 void Animator::updatePose() {
+	samplePose(m_currentTime, false);
+	m_skeleton->calculateMatrixPalette(m_currentPose, m_matrixPalette);
+
+	// The next interpolated update starts from this palette
+	m_interpolationStep = m_interpolationStepsCount;
+	m_isMatrixPaletteOutdated = false;
+}
+
+void Animator::updateInterpolatedPose(float delta, size_t updateInterval)
+{
+	if (m_interpolationStep >= m_interpolationStepsCount) {
+		// Sample the pose that should be shown after updateInterval ticks (one of them is the current tick)
+		// and blend the palette towards it on every tick in between
+		m_sourceMatrixPalette = m_matrixPalette;
+
+		bool skipHelperBones = m_levelOfDetail == LevelOfDetail::Low && m_lodPolicy.skipHelperBonesAtLowDetail;
+		samplePose(getAnimationTimeAfter(delta * (updateInterval - 1)), skipHelperBones);
+
+		m_targetMatrixPalette = m_sourceMatrixPalette;
+		m_skeleton->calculateMatrixPalette(m_currentPose, m_targetMatrixPalette);
+
+		m_interpolationStep = 0;
+		m_interpolationStepsCount = updateInterval;
+	}
+
+	m_interpolationStep++;
+
+	float interpolationFactor = (float)m_interpolationStep / m_interpolationStepsCount;
+
+	for (size_t boneIndex = 0; boneIndex < m_matrixPalette.size(); boneIndex++) {
+		m_matrixPalette[boneIndex] = m_sourceMatrixPalette[boneIndex] * (1.0f - interpolationFactor) + 
+			m_targetMatrixPalette[boneIndex] * interpolationFactor;
+	}
+}
+
+float Animator::getAnimationTimeAfter(float delta) const
+{
+	float time = m_currentTime + delta * m_currentAnimation->getSpeed() * m_currentAnimation->getSpeedFactor();
+
+	if (time > m_currentAnimation->getDuration()) {
+		if (m_currentAnimation->getEndBehaviour() == Animation::EndBehaviour::Repeat)
+			time = fmod(time, m_currentAnimation->getDuration());
+		else
+			time = m_currentAnimation->getDuration();
+	}
+
+	return time;
+}
+
+void Animator::samplePose(float time, bool skipHelperBones) {
 	m_currentPose.reset();
 
 	for (const BoneAnimation& boneAnimation : m_currentAnimation->getBonesAnimations()) {
-		size_t boneTransformIndex = m_skeleton->getBones()[boneAnimation.getBoneIndex()].getId();
+		const Bone& bone = m_skeleton->getBones()[boneAnimation.getBoneIndex()];
+
+		if (skipHelperBones && bone.isHelperDummy())
+			continue;
+
+		size_t boneTransformIndex = bone.getId();
 
 		const BonePositionKeyFrame* nextPosition = &boneAnimation.getPositionKeyFrames()[0];
 		const BonePositionKeyFrame* prevPosition = &boneAnimation.getPositionKeyFrames()[0];
@@ -59,7 +147,7 @@ void Animator::updatePose() {
 		for (const BonePositionKeyFrame& keyFrame : boneAnimation.getPositionKeyFrames()) {
 			nextPosition = &keyFrame;
 
-			if (keyFrame.timeStamp > m_currentTime) {
+			if (keyFrame.timeStamp > time) {
 				break;
 			}
 
@@ -72,7 +160,7 @@ void Animator::updatePose() {
 		for (const BoneOrientationKeyFrame& keyFrame : boneAnimation.getOrientationKeyFrames()) {
 			nextOrientation = &keyFrame;
 
-			if (keyFrame.timeStamp > m_currentTime) {
+			if (keyFrame.timeStamp > time) {
 				break;
 			}
 
@@ -88,7 +176,7 @@ void Animator::updatePose() {
 			positionsProgress = 0.0f;
 		}
 		else {
-			positionsProgress = (m_currentTime - prevPosition->timeStamp) / positionsDelta;
+			positionsProgress = (time - prevPosition->timeStamp) / positionsDelta;
 		}
 
 		vector3 interpolatedPosition = glm::mix(prevPosition->position, nextPosition->position, positionsProgress);
@@ -101,13 +189,12 @@ void Animator::updatePose() {
 			orientationsProgress = 0.0f;
 		}
 		else {
-			orientationsProgress = (m_currentTime - prevOrientation->timeStamp) / orientationsDelta;
+			orientationsProgress = (time - prevOrientation->timeStamp) / orientationsDelta;
 		}
 
 		quaternion interpolatedOrientation = glm::slerp(prevOrientation->orientation, nextOrientation->orientation, orientationsProgress);
 
-		matrix4 boneTransform = glm::translate(matrix4(), interpolatedPosition) * glm::toMat4(interpolatedOrientation) * glm::scale(vector3(1.0f, 1.0f, 1.0f));
-		m_currentPose.setBoneTransform(boneTransformIndex, boneTransform);
+		m_currentPose.setBoneTransform(boneTransformIndex, interpolatedPosition, interpolatedOrientation);
 	}
 }
 
@@ -134,4 +221,63 @@ void Animator::stop()
 const SkeletonPose & Animator::getAnimatedPose() const
 {
 	return m_currentPose;
+}
+
+const std::vector<matrix4>& Animator::getMatrixPalette() const
+{
+	return m_matrixPalette;
+}
+
+const Skeleton * Animator::getSkeleton() const
+{
+	return m_skeleton;
+}
+
+void Animator::setLODPolicy(const AnimationLODPolicy & policy)
+{
+	m_lodPolicy = policy;
+}
+
+const AnimationLODPolicy & Animator::getLODPolicy() const
+{
+	return m_lodPolicy;
+}
+
+void Animator::updateLevelOfDetail(float distanceToViewer, bool isVisible)
+{
+	if (!isVisible && m_lodPolicy.pauseInvisible)
+		setLevelOfDetail(LevelOfDetail::Paused);
+	else if (distanceToViewer <= m_lodPolicy.fullDetailDistance)
+		setLevelOfDetail(LevelOfDetail::Full);
+	else if (distanceToViewer <= m_lodPolicy.reducedDetailDistance)
+		setLevelOfDetail(LevelOfDetail::Reduced);
+	else
+		setLevelOfDetail(LevelOfDetail::Low);
+}
+
+void Animator::setLevelOfDetail(LevelOfDetail levelOfDetail)
+{
+	if (m_levelOfDetail == LevelOfDetail::Paused && levelOfDetail != LevelOfDetail::Paused)
+		m_isMatrixPaletteOutdated = true;
+
+	m_levelOfDetail = levelOfDetail;
+}
+
+Animator::LevelOfDetail Animator::getLevelOfDetail() const
+{
+	return m_levelOfDetail;
+}
+
+size_t Animator::getUpdateInterval() const
+{
+	switch (m_levelOfDetail) {
+	case LevelOfDetail::Reduced:
+		return m_lodPolicy.reducedDetailUpdateInterval;
+
+	case LevelOfDetail::Low:
+		return m_lodPolicy.lowDetailUpdateInterval;
+
+	default:
+		return 1;
+	}
 }
\ No newline at end of file
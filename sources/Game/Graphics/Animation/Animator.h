@@ -3,14 +3,31 @@
 #include "Animation.h"
 #include "Skeleton.h"
 
+struct AnimationLODPolicy {
+	// Distances to the viewer where the detail level goes down
+	float fullDetailDistance = 8.0f;
+	float reducedDetailDistance = 20.0f;
+
+	// Pose is sampled once per interval ticks and interpolated between the samples
+	size_t reducedDetailUpdateInterval = 2;
+	size_t lowDetailUpdateInterval = 4;
+
+	bool skipHelperBonesAtLowDetail = true;
+	bool pauseInvisible = true;
+};
+
 class Animator {
 public:
 	enum class AnimationState {
 		Playing, Stopped
 	};
 
+	enum class LevelOfDetail {
+		Full, Reduced, Low, Paused
+	};
+
 public:
-	Animator(Skeleton* skeleton);
+	Animator(const Skeleton* skeleton);
 	~Animator();
 
 	void setCurrentAnimation(Animation* animation);
@@ -18,6 +35,10 @@ public:
 
 	void increaseAnimationTime(float delta);
 
+	// Jumps to the given time of the current animation, ticks. The pose is updated by the next increaseAnimationTime call
+	void setCurrentTime(float time);
+	float getCurrentTime() const;
+
 	bool isPlaying() const;
 	bool isStopped() const;
 
@@ -26,12 +47,31 @@ public:
 
 	const SkeletonPose& getAnimatedPose() const;
 
+	// Final skinning transforms of the instance, one per skeleton bone
+	const std::vector<matrix4>& getMatrixPalette() const;
+
+	const Skeleton* getSkeleton() const;
+
+	void setLODPolicy(const AnimationLODPolicy& policy);
+	const AnimationLODPolicy& getLODPolicy() const;
+
+	void updateLevelOfDetail(float distanceToViewer, bool isVisible);
+
+	void setLevelOfDetail(LevelOfDetail levelOfDetail);
+	LevelOfDetail getLevelOfDetail() const;
+
 private:
 	void updatePose();
+	void updateInterpolatedPose(float delta, size_t updateInterval);
+
+	void samplePose(float time, bool skipHelperBones);
+	float getAnimationTimeAfter(float delta) const;
+
+	size_t getUpdateInterval() const;
 
 private:
 	Animation* m_currentAnimation;
-	Skeleton* m_skeleton;
+	const Skeleton* m_skeleton;
 
 	// Current animation time, between 0 and duration
 	float m_currentTime;
@@ -39,4 +79,19 @@ private:
 	AnimationState m_currentAnimationState;
 
 	SkeletonPose m_currentPose;
+	std::vector<matrix4> m_matrixPalette;
+
+private:
+	AnimationLODPolicy m_lodPolicy;
+	LevelOfDetail m_levelOfDetail;
+
+	// Palettes of the last and the next sampled poses for reduced update rates
+	std::vector<matrix4> m_sourceMatrixPalette;
+	std::vector<matrix4> m_targetMatrixPalette;
+
+	size_t m_interpolationStep;
+	size_t m_interpolationStepsCount;
+
+	// Palette doesn't match the current animation (it was changed or the animator was paused)
+	bool m_isMatrixPaletteOutdated;
 };
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include "BakedAnimation.h"
+
+BakedAnimation::BakedAnimation(Texture * bonesTexture, size_t bonesCount, size_t framesCount, float framesPerSecond, bool isLooped)
+	: m_bonesTexture(bonesTexture),
+	m_bonesCount(bonesCount),
+	m_framesCount(framesCount),
+	m_framesPerSecond(framesPerSecond),
+	m_isLooped(isLooped)
+{
+}
+
+BakedAnimation::~BakedAnimation()
+{
+	delete m_bonesTexture;
+}
+
+Texture * BakedAnimation::getBonesTexture() const
+{
+	return m_bonesTexture;
+}
+
+size_t BakedAnimation::getBonesCount() const
+{
+	return m_bonesCount;
+}
+
+size_t BakedAnimation::getFramesCount() const
+{
+	return m_framesCount;
+}
+
+float BakedAnimation::getFramesPerSecond() const
+{
+	return m_framesPerSecond;
+}
+
+float BakedAnimation::getDuration() const
+{
+	// The final pose of a not looped animation is shown at the end of the duration
+	size_t intervalsCount = m_isLooped ? m_framesCount : m_framesCount - 1;
+
+	return intervalsCount / m_framesPerSecond;
+}
+
+bool BakedAnimation::isLooped() const
+{
+	return m_isLooped;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <Engine\Components\Graphics\RenderSystem\Texture.h>
+
+// Animation sampled into a float texture: every row is a frame, every bone takes
+// TEXELS_PER_BONE texels with the first three rows of its skinning matrix.
+// The last frame of a not looped animation is its final pose
+class BakedAnimation {
+public:
+	BakedAnimation(Texture* bonesTexture, size_t bonesCount, size_t framesCount, float framesPerSecond, bool isLooped);
+	~BakedAnimation();
+
+	Texture* getBonesTexture() const;
+
+	size_t getBonesCount() const;
+	size_t getFramesCount() const;
+
+	float getFramesPerSecond() const;
+
+	// Duration, seconds
+	float getDuration() const;
+
+	bool isLooped() const;
+
+public:
+	static const size_t TEXELS_PER_BONE = 3;
+
+private:
+	Texture* m_bonesTexture;
+
+	size_t m_bonesCount;
+	size_t m_framesCount;
+
+	float m_framesPerSecond;
+	bool m_isLooped;
+};
@@ -15,7 +15,6 @@ Bone::Bone(size_t id,
 	m_localToBoneSpaceTransform(localToBoneSpaceTransform),
 	m_relativeToParentSpaceTransform(relativeToParentSpaceTransform)
 {
-	m_currentPoseTransform = matrix4(1.0f);
 }
 
 Bone::~Bone()
@@ -66,13 +65,3 @@ size_t Bone::getChildrenCount() const
 {
 	return m_children.size();
 }
-
-const matrix4 & Bone::getCurrentPoseTransform() const
-{
-	return m_currentPoseTransform;
-}
-
-void Bone::setCurrentPoseTransform(const matrix4 & transform)
-{
-	m_currentPoseTransform = transform;
-}
@@ -29,9 +29,6 @@ public:
 
 	const matrix4& getLocalToBoneSpaceTransform() const;
 	const matrix4& getRelativeToParentSpaceTransform() const;
-
-	const matrix4& getCurrentPoseTransform() const;
-	void setCurrentPoseTransform(const matrix4& transform);
 private:
 	size_t m_id;
 	std::string m_name;
@@ -43,6 +40,4 @@ private:
 	std::vector<size_t> m_children;
 	matrix4 m_localToBoneSpaceTransform;
 	matrix4 m_relativeToParentSpaceTransform;
-
-	matrix4 m_currentPoseTransform;
 };
\ No newline at end of file
@@ -17,6 +17,9 @@ Skeleton::Skeleton(const std::vector<Bone>& bones, const matrix4& globalInverseT
 
 	if (!rootBoneFound)
 		throw EngineException("Skeleton must contains root bone", __FILE__, __LINE__, __FUNCTION__);
+
+	if (m_bones.size() > SkeletonPose::MAX_BONES_COUNT)
+		throw EngineException("Skeleton bones count exceeds the pose capacity", __FILE__, __LINE__, __FUNCTION__);
 }
 
 Skeleton::~Skeleton()
@@ -63,41 +66,35 @@ std::vector<Bone*> Skeleton::getChildBones(size_t boneId) const
 	return childBones;
 }
 
-void Skeleton::resetPose()
-{
-	for (Bone& bone : m_bones)
-		bone.setCurrentPoseTransform(matrix4());
-}
-
 const matrix4 & Skeleton::getGlobalInverseTransform() const
 {
 	return m_globalInverseTransform;
 }
 
-void Skeleton::applyPose(const SkeletonPose & pose)
+void Skeleton::calculateMatrixPalette(const SkeletonPose & pose, std::vector<matrix4>& matrixPalette) const
 {
-	applyTransformsToBonesHierarchy(pose, m_rootBone, matrix4());
-}
+	matrixPalette.resize(m_bones.size(), matrix4(1.0f));
 
-const matrix4& Skeleton::getLocalBoneTransform(size_t boneId) const
-{
-	return m_bones[boneId].getCurrentPoseTransform();
+	calculateBonesHierarchyTransforms(pose, m_rootBone, matrix4(), matrixPalette);
 }
 
-void Skeleton::applyTransformsToBonesHierarchy(const SkeletonPose& pose, Bone* bone, const matrix4& parentTransform) {
+void Skeleton::calculateBonesHierarchyTransforms(const SkeletonPose& pose, const Bone* bone, 
+	const matrix4& parentTransform, std::vector<matrix4>& matrixPalette) const 
+{
 	matrix4 currentBoneTransform;
+	bool isBoneAffected = pose.isBoneAffected(bone->getId());
 
-	if (!pose.isBoneAffected(bone->getId())) {
+	if (!isBoneAffected) {
 		currentBoneTransform = parentTransform * bone->getRelativeToParentSpaceTransform();
 	}
 	else {
-		currentBoneTransform = parentTransform * pose.getBoneTransform(bone->getId());
+		currentBoneTransform = parentTransform * pose.getBoneTransform(bone->getId()).getTransformationMatrix();
 	}
 
-	for (size_t childId : m_bones[bone->getId()].getChildren()) {
-		applyTransformsToBonesHierarchy(pose, &m_bones[childId], currentBoneTransform);
+	for (size_t childId : bone->getChildren()) {
+		calculateBonesHierarchyTransforms(pose, &m_bones[childId], currentBoneTransform, matrixPalette);
 	}
 
-	if (pose.isBoneAffected(bone->getId()))
-		bone->setCurrentPoseTransform(m_globalInverseTransform * currentBoneTransform * bone->getLocalToBoneSpaceTransform());
+	if (isBoneAffected)
+		matrixPalette[bone->getId()] = m_globalInverseTransform * currentBoneTransform * bone->getLocalToBoneSpaceTransform();
 }
\ No newline at end of file
@@ -17,15 +17,14 @@ public:
 	Bone* getRootBone() const;
 	std::vector<Bone*> getChildBones(size_t boneId) const;
 
-	void resetPose();
-
 	const matrix4& getGlobalInverseTransform() const;
 
-	void applyPose(const SkeletonPose& pose);
-
-	const matrix4& getLocalBoneTransform(size_t boneId) const;
+	// Skeleton is shared between all instances of the mesh, so the pose is applied
+	// to the instance-owned matrix palette instead of the bones
+	void calculateMatrixPalette(const SkeletonPose& pose, std::vector<matrix4>& matrixPalette) const;
 private:
-	void applyTransformsToBonesHierarchy(const SkeletonPose& pose, Bone* bone, const matrix4& parentTransform);
+	void calculateBonesHierarchyTransforms(const SkeletonPose& pose, const Bone* bone, 
+		const matrix4& parentTransform, std::vector<matrix4>& matrixPalette) const;
 	
 private:
 	std::vector<Bone> m_bones;
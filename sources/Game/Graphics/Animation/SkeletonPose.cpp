@@ -1,9 +1,21 @@
 #include "SkeletonPose.h"
 
+#include <Engine\assertions.h>
+
+matrix4 BoneTransform::getTransformationMatrix() const
+{
+	matrix4 transform = glm::toMat4(orientation);
+	transform[3] = vector4(position, 1.0f);
+
+	return transform;
+}
+
 SkeletonPose::SkeletonPose(size_t bonesCount)
-	: m_currentPoseTransforms(bonesCount), m_currentPoseTransformsMarks(bonesCount, false)
+	: m_bonesCount(bonesCount)
 {
+	_assert(bonesCount <= MAX_BONES_COUNT);
 
+	reset();
 }
 
 SkeletonPose::~SkeletonPose()
@@ -12,21 +24,31 @@ SkeletonPose::~SkeletonPose()
 
 void SkeletonPose::reset()
 {
-	std::fill(m_currentPoseTransformsMarks.begin(), m_currentPoseTransformsMarks.end(), false);
+	size_t usedWordsCount = (m_bonesCount + MARKS_WORD_SIZE - 1) / MARKS_WORD_SIZE;
+
+	for (size_t wordIndex = 0; wordIndex < usedWordsCount; wordIndex++)
+		m_affectedBonesMarks[wordIndex] = 0;
 }
 
-void SkeletonPose::setBoneTransform(size_t boneId, const matrix4 & transform)
+void SkeletonPose::setBoneTransform(size_t boneId, const vector3& position, const quaternion& orientation)
 {
-	m_currentPoseTransforms[boneId] = transform;
-	m_currentPoseTransformsMarks[boneId] = true;
+	m_bonesTransforms[boneId].position = position;
+	m_bonesTransforms[boneId].orientation = orientation;
+
+	m_affectedBonesMarks[boneId / MARKS_WORD_SIZE] |= uint64(1) << (boneId % MARKS_WORD_SIZE);
 }
 
 bool SkeletonPose::isBoneAffected(size_t boneId) const
 {
-	return m_currentPoseTransformsMarks[boneId];
+	return (m_affectedBonesMarks[boneId / MARKS_WORD_SIZE] >> (boneId % MARKS_WORD_SIZE)) & 1;
+}
+
+const BoneTransform & SkeletonPose::getBoneTransform(size_t boneId) const
+{
+	return m_bonesTransforms[boneId];
 }
 
-const matrix4 & SkeletonPose::getBoneTransform(size_t boneId) const
+size_t SkeletonPose::getBonesCount() const
 {
-	return m_currentPoseTransforms[boneId];
+	return m_bonesCount;
 }
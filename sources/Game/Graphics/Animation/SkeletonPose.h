@@ -1,8 +1,16 @@
 #pragma once
 
-#include <vector>
+#include <Engine\types.h>
 #include <Engine\Components\Math\types.h>
 
+// Bone transform relative to the parent bone, scale is not animated
+struct BoneTransform {
+	vector3 position;
+	quaternion orientation;
+
+	matrix4 getTransformationMatrix() const;
+};
+
 class SkeletonPose {
 public:
 	SkeletonPose(size_t bonesCount);
@@ -10,11 +18,25 @@ public:
 
 	void reset();
 
-	void setBoneTransform(size_t boneId, const matrix4& transform);
+	void setBoneTransform(size_t boneId, const vector3& position, const quaternion& orientation);
 
 	bool isBoneAffected(size_t boneId) const;
-	const matrix4& getBoneTransform(size_t boneId) const;
+	const BoneTransform& getBoneTransform(size_t boneId) const;
+
+	size_t getBonesCount() const;
+
+public:
+	static const size_t MAX_BONES_COUNT = 128;
+
+private:
+	static const size_t MARKS_WORD_SIZE = 64;
+	static const size_t MARKS_WORDS_COUNT = MAX_BONES_COUNT / MARKS_WORD_SIZE;
+
 private:
-	std::vector<matrix4> m_currentPoseTransforms;
-	std::vector<bool> m_currentPoseTransformsMarks;
-};
\ No newline at end of file
+	alignas(64) BoneTransform m_bonesTransforms[MAX_BONES_COUNT];
+
+	// Bit per bone, set if the bone transform is set since the last reset
+	uint64 m_affectedBonesMarks[MARKS_WORDS_COUNT];
+
+	size_t m_bonesCount;
+};
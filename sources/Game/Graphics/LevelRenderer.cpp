@@ -33,22 +33,26 @@ LevelRenderer::~LevelRenderer()
 }
 
 void LevelRenderer::registerLightSource(Light * lightSource) {
-	m_lightsSources.push_back(lightSource);
-	updateLightSource(lightSource);
+	m_addedLightsSources.push_back(lightSource);
 }
 
 void LevelRenderer::updateLightSource(const Light * lightSource)
 {
 	for (size_t lightSourceIndex = 0; lightSourceIndex < m_lightsSources.size(); lightSourceIndex++) {
 		if (lightSource == m_lightsSources[lightSourceIndex]) {
-			passLightSourceDataToGpuProgram(lightSource->getGameObjectId(), lightSource, m_deferredLightingProgram);
+			passLightSourceDataToGpuProgram(lightSourceIndex, lightSource, m_deferredLightingProgram);
 			break;
 		}
 	}
 }
 
 void LevelRenderer::removeLightSource(const Light * lightSource) {
-	m_lightsSources.erase(std::remove(m_lightsSources.begin(), m_lightsSources.end(), lightSource), m_lightsSources.end());
+	auto addedLightSource = std::find(m_addedLightsSources.begin(), m_addedLightsSources.end(), lightSource);
+
+	if (addedLightSource != m_addedLightsSources.end())
+		m_addedLightsSources.erase(addedLightSource);
+	else
+		m_removedLightsSources.push_back(lightSource);
 }
 
 void LevelRenderer::setActiveCamera(const Camera * camera)
@@ -56,14 +60,61 @@ void LevelRenderer::setActiveCamera(const Camera * camera)
 	m_activeCamera = camera;
 }
 
+void LevelRenderer::prepareRendering()
+{
+	applyObjectsChanges();
+
+	m_viewMatrix = m_activeCamera->getViewMatrix();
+	m_projectionMatrix = m_activeCamera->getProjectionMatrix();
+	m_cameraPosition = m_activeCamera->getTransform()->getPosition();
+
+	for (Renderable* renderableObject : m_renderableObjects)
+		renderableObject->prepareRendering();
+}
+
+void LevelRenderer::applyObjectsChanges()
+{
+	// Removals go first, so the object removed and added back again stays in the set
+	size_t lightsSourcesCount = m_lightsSources.size();
+
+	for (const Light* lightSource : m_removedLightsSources)
+		m_lightsSources.erase(std::remove(m_lightsSources.begin(), m_lightsSources.end(), lightSource), m_lightsSources.end());
+
+	// Lights are placed in the program by their index in the set, so the lights after the removed ones are moved
+	if (m_lightsSources.size() != lightsSourcesCount) {
+		for (size_t lightSourceIndex = 0; lightSourceIndex < m_lightsSources.size(); lightSourceIndex++)
+			passLightSourceDataToGpuProgram(lightSourceIndex, m_lightsSources[lightSourceIndex], m_deferredLightingProgram);
+
+		for (size_t lightSourceIndex = m_lightsSources.size(); lightSourceIndex < lightsSourcesCount; lightSourceIndex++)
+			clearLightSourceDataInGpuProgram(lightSourceIndex, m_deferredLightingProgram);
+	}
+
+	for (const Light* lightSource : m_addedLightsSources) {
+		m_lightsSources.push_back(lightSource);
+		updateLightSource(lightSource);
+	}
+
+	for (Renderable* object : m_removedRenderableObjects)
+		m_renderableObjects.erase(std::remove(m_renderableObjects.begin(), m_renderableObjects.end(), object),
+			m_renderableObjects.end());
+
+	m_renderableObjects.insert(m_renderableObjects.end(), m_addedRenderableObjects.begin(), m_addedRenderableObjects.end());
+
+	m_removedLightsSources.clear();
+	m_addedLightsSources.clear();
+
+	m_removedRenderableObjects.clear();
+	m_addedRenderableObjects.clear();
+}
+
 void LevelRenderer::prepareBaseMaterials() {
 	for (const BaseMaterial* baseMaterial : m_baseMaterials) {
 		GpuProgram* gpuProgram = baseMaterial->getGpuProgram();
 		gpuProgram->bind();
 
 		if (baseMaterial->isTransformsDataRequired()) {
-			gpuProgram->setParameter("scene.viewTransform", m_activeCamera->getViewMatrix());
-			gpuProgram->setParameter("scene.projectionTransform", m_activeCamera->getProjectionMatrix());
+			gpuProgram->setParameter("scene.viewTransform", m_viewMatrix);
+			gpuProgram->setParameter("scene.projectionTransform", m_projectionMatrix);
 		}
 	}
 }
@@ -109,7 +160,7 @@ void LevelRenderer::render()
 
 	// Lighting passes
 	m_deferredLightingProgram->bind();
-	m_deferredLightingProgram->setParameter("g_cameraPosition", m_activeCamera->getTransform()->getPosition());
+	m_deferredLightingProgram->setParameter("g_cameraPosition", m_cameraPosition);
 
 	m_gBufferPosition->bind(POSITION_BUFFER_INDEX);
 	m_gBufferAlbedo->bind(ALBEDO_BUFFER_INDEX);
@@ -182,6 +233,18 @@ void LevelRenderer::passLightSourceDataToGpuProgram(size_t index, const Light* l
 	gpuProgram->setParameter(item + ".boundingRadius", boundingRadius);
 }
 
+void LevelRenderer::clearLightSourceDataInGpuProgram(size_t index, GpuProgram * gpuProgram) const
+{
+	gpuProgram->bind();
+
+	std::string item = "g_lights[" + std::to_string(index) + "]";
+
+	gpuProgram->setParameter(item + ".parameters.color", vector3(0.0f, 0.0f, 0.0f));
+	gpuProgram->setParameter(item + ".parameters.ambientIntensity", 0.0f);
+	gpuProgram->setParameter(item + ".parameters.diffuseIntensity", 0.0f);
+	gpuProgram->setParameter(item + ".boundingRadius", 0.0f);
+}
+
 void LevelRenderer::registerBaseMaterial(BaseMaterial * baseMaterial)
 {
 	m_baseMaterials.push_back(baseMaterial);
@@ -189,13 +252,17 @@ void LevelRenderer::registerBaseMaterial(BaseMaterial * baseMaterial)
 
 void LevelRenderer::addRenderableObject(Renderable * object)
 {
-	m_renderableObjects.push_back(object);
+	m_addedRenderableObjects.push_back(object);
 }
 
 void LevelRenderer::removeRenderableObject(Renderable * object)
 {
-	m_renderableObjects.erase(std::remove(m_renderableObjects.begin(), m_renderableObjects.end(), object),
-		m_renderableObjects.end());
+	auto addedObject = std::find(m_addedRenderableObjects.begin(), m_addedRenderableObjects.end(), object);
+
+	if (addedObject != m_addedRenderableObjects.end())
+		m_addedRenderableObjects.erase(addedObject);
+	else
+		m_removedRenderableObjects.push_back(object);
 }
 
 void LevelRenderer::enableGammaCorrection()
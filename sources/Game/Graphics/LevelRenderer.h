@@ -23,6 +23,10 @@ public:
 	void removeLightSource(const Light* lightSource);
 
 	void setActiveCamera(const Camera* camera);
+
+	// Applies the changes of the objects and lights sets and copies the state of the camera and the objects,
+	// so render doesn't read the state changed by the updates
+	void prepareRendering();
 	void render();
 
 	void registerBaseMaterial(BaseMaterial* baseMaterial);
@@ -38,12 +42,16 @@ public:
 	float getGamma() const;
 
 protected:
+	void applyObjectsChanges();
 	void prepareBaseMaterials();
 	void showGBuffer();
 
 	float calculateLightSourceSphereRadius(const Light* light) const;
 	void passLightSourceDataToGpuProgram(size_t index, const Light* light, GpuProgram* gpuProgram) const;
 
+	// Turns off the light slot left after the removed light
+	void clearLightSourceDataInGpuProgram(size_t index, GpuProgram* gpuProgram) const;
+
 	void initializeRenderTarget();
 	Texture* createGBufferColorTexture();
 	Texture* createGBufferDepthStencilTexture();
@@ -63,6 +71,17 @@ protected:
 	std::vector<BaseMaterial*> m_baseMaterials;
 	std::vector<Renderable*> m_renderableObjects;
 
+	// Objects and lights are added and removed by the updates, the rendered sets are changed before rendering
+	std::vector<const Light*> m_addedLightsSources;
+	std::vector<const Light*> m_removedLightsSources;
+
+	std::vector<Renderable*> m_addedRenderableObjects;
+	std::vector<Renderable*> m_removedRenderableObjects;
+
+	matrix4 m_viewMatrix;
+	matrix4 m_projectionMatrix;
+	vector3 m_cameraPosition;
+
 protected:
 	GpuProgram* m_deferredLightingProgram;
 
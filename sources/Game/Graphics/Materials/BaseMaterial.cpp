@@ -7,7 +7,8 @@ BaseMaterial::BaseMaterial(const std::string & name,
 	m_graphicsPipelineState(),
 	m_supportDeferred(false),
 	m_lightsDataRequired(false),
-	m_transformsDataRequired(false)
+	m_transformsDataRequired(false),
+	m_skinningMethod(SkinningMethod::LinearBlend)
 {
 }
 
@@ -50,6 +51,16 @@ GpuProgram * BaseMaterial::getGpuProgram() const
 	return m_gpuProgram;
 }
 
+void BaseMaterial::setSkinningMethod(SkinningMethod method)
+{
+	m_skinningMethod = method;
+}
+
+BaseMaterial::SkinningMethod BaseMaterial::getSkinningMethod() const
+{
+	return m_skinningMethod;
+}
+
 const GraphicsPipelineState & BaseMaterial::getRequiredGraphicsPipelineState() const
 {
 	return m_graphicsPipelineState;
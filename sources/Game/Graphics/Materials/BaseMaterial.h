@@ -6,6 +6,12 @@
 #include "MaterialParameters.h"
 
 class BaseMaterial {
+public:
+	// Format of the bones palette expected by the GPU program
+	enum class SkinningMethod {
+		LinearBlend, DualQuaternion
+	};
+
 public:
 	BaseMaterial(const std::string& name, GpuProgram* gpuProgram);
 	virtual ~BaseMaterial();
@@ -23,12 +29,17 @@ public:
 
 	GpuProgram* getGpuProgram() const;
 
+	void setSkinningMethod(SkinningMethod method);
+	SkinningMethod getSkinningMethod() const;
+
 	const GraphicsPipelineState& getRequiredGraphicsPipelineState() const;
 protected:
 	bool m_transformsDataRequired;
 	bool m_lightsDataRequired;
 
 	bool m_supportDeferred;
+
+	SkinningMethod m_skinningMethod;
 protected:
 	std::string m_name;
 
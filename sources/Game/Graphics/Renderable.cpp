@@ -9,6 +9,10 @@ Renderable::~Renderable()
 {
 }
 
+void Renderable::prepareRendering()
+{
+}
+
 BaseMaterial * Renderable::getBaseMaterial() const
 {
 	return m_baseMaterial;
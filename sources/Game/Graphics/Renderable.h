@@ -9,6 +9,8 @@ public:
 	Renderable(BaseMaterial* baseMaterial);
 	~Renderable();
 
+	// Copies the state changed by the updates, render shouldn't read anything else of the object
+	virtual void prepareRendering();
 	virtual void render() = 0;
 
 	BaseMaterial* getBaseMaterial() const;
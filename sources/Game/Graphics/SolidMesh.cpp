@@ -1,16 +1,33 @@
 #include "SolidMesh.h"
 
+#include <Engine\assertions.h>
+#include <Engine\Components\Math\DualQuaternion.h>
+
 SolidMesh::SolidMesh(GeometryStore * geometry, 
 	const std::vector<size_t>& groupsOffsets, 
 	const std::vector<MaterialParameters*>& materials,
 	const std::vector<OBB>& colliders,
+	BoundingVolumeHierarchy* collidersHierarchy,
+	TriangleMeshHierarchy* trianglesHierarchy,
 	Skeleton* skeleton)
 	: m_geometry(geometry), 
 	m_groupsOffsets(groupsOffsets),
 	m_materialsParameters(materials),
 	m_colliders(colliders),
+	m_collidersHierarchy(collidersHierarchy),
+	m_trianglesHierarchy(trianglesHierarchy),
 	m_skeleton(skeleton)
 {
+	if (m_collidersHierarchy != nullptr)
+		return;
+
+	std::vector<AABB> collidersBounds;
+	collidersBounds.reserve(m_colliders.size());
+
+	for (const OBB& collider : m_colliders)
+		collidersBounds.push_back(collider.getBoundingBox());
+
+	m_collidersHierarchy = new BoundingVolumeHierarchy(collidersBounds);
 }
 
 SolidMesh::~SolidMesh()
@@ -20,23 +37,56 @@ SolidMesh::~SolidMesh()
 
 	if (m_skeleton != nullptr)
 		delete m_skeleton;
+
+	delete m_collidersHierarchy;
+	delete m_trianglesHierarchy;
 }
 
 void SolidMesh::render(BaseMaterial* baseMaterial) {
-	bool isAnimated = m_skeleton != nullptr;
+	baseMaterial->getGpuProgram()->setParameter("animation.isAnimated", false);
+
+	renderGeometry(baseMaterial, 1);
+}
+
+void SolidMesh::render(BaseMaterial * baseMaterial, const std::vector<matrix4>& matrixPalette)
+{
+	_assert(m_skeleton != nullptr && matrixPalette.size() == m_skeleton->getBonesCount());
 
 	GpuProgram* gpuProgram = baseMaterial->getGpuProgram();
-	gpuProgram->setParameter("animation.isAnimated", isAnimated);
+	gpuProgram->setParameter("animation.isAnimated", true);
 
-	if (isAnimated) {
-		size_t boneIndex = 0;
+	if (baseMaterial->getSkinningMethod() == BaseMaterial::SkinningMethod::DualQuaternion)
+		uploadDualQuaternionsPalette(gpuProgram, matrixPalette);
+	else
+		gpuProgram->setParameter("animation.bones[0]", matrixPalette.data(), matrixPalette.size());
 
-		for (const Bone& bone : m_skeleton->getBones()) {
-			baseMaterial->getGpuProgram()->setParameter("animation.bones[" + std::to_string(boneIndex) + "]", bone.getCurrentPoseTransform());
-			boneIndex++;
-		}
+	renderGeometry(baseMaterial, 1);
+}
+
+void SolidMesh::uploadDualQuaternionsPalette(GpuProgram * gpuProgram, const std::vector<matrix4>& matrixPalette)
+{
+	m_dualQuaternionsPalette.resize(matrixPalette.size() * 2);
+
+	for (size_t boneIndex = 0; boneIndex < matrixPalette.size(); boneIndex++) {
+		DualQuaternion boneTransform = DualQuaternion::fromMatrix(matrixPalette[boneIndex]);
+
+		const quaternion& real = boneTransform.getReal();
+		const quaternion& dual = boneTransform.getDual();
+
+		m_dualQuaternionsPalette[boneIndex * 2] = vector4(real.x, real.y, real.z, real.w);
+		m_dualQuaternionsPalette[boneIndex * 2 + 1] = vector4(dual.x, dual.y, dual.z, dual.w);
 	}
 
+	gpuProgram->setParameter("animation.dualQuaternions[0]", m_dualQuaternionsPalette.data(), m_dualQuaternionsPalette.size());
+}
+
+void SolidMesh::renderInstanced(BaseMaterial * baseMaterial, size_t instancesCount)
+{
+	renderGeometry(baseMaterial, instancesCount);
+}
+
+void SolidMesh::renderGeometry(BaseMaterial * baseMaterial, size_t instancesCount)
+{
 	m_geometry->bind();
 
 	for (size_t i = 0; i < m_groupsOffsets.size(); i++) {
@@ -45,16 +95,32 @@ void SolidMesh::render(BaseMaterial* baseMaterial) {
 		size_t groupOffset = (i == 0) ? 0 : m_groupsOffsets[i - 1];
 		size_t count = (i == 0) ? m_groupsOffsets[0] : m_groupsOffsets[i] - m_groupsOffsets[i - 1];
 
-		m_geometry->drawElements(GeometryStore::DrawType::Triangles, groupOffset, count, 
-			GeometryStore::IndicesType::UnsignedInt);
+		if (instancesCount == 1) {
+			m_geometry->drawElements(GeometryStore::DrawType::Triangles, groupOffset, count,
+				GeometryStore::IndicesType::UnsignedInt);
+		}
+		else {
+			m_geometry->drawElementsInstanced(GeometryStore::DrawType::Triangles, groupOffset, count,
+				GeometryStore::IndicesType::UnsignedInt, instancesCount);
+		}
 	}
 }
 
-std::vector<OBB> SolidMesh::getColliders() const
+const std::vector<OBB>& SolidMesh::getColliders() const
 {
 	return m_colliders;
 }
 
+const BoundingVolumeHierarchy * SolidMesh::getCollidersHierarchy() const
+{
+	return m_collidersHierarchy;
+}
+
+const TriangleMeshHierarchy * SolidMesh::getTrianglesHierarchy() const
+{
+	return m_trianglesHierarchy;
+}
+
 bool SolidMesh::hasSkeleton() const
 {
 	return m_skeleton != nullptr;
@@ -5,6 +5,8 @@
 #include <Engine\Components\Graphics\RenderSystem\GpuProgram.h>
 #include <Engine\Components\Graphics\RenderSystem\GraphicsContext.h>
 #include <Engine\Components\Physics\Colliders\OBB.h>
+#include <Engine\Components\Physics\Broadphase\BoundingVolumeHierarchy.h>
+#include <Engine\Components\Physics\TriangleMeshHierarchy.h>
 
 #include <Game\Graphics\Animation\Skeleton.h>
 #include <Game\Graphics\Materials\BaseMaterial.h>
@@ -17,22 +19,45 @@ public:
 		const std::vector<size_t>& groupsOffsets, 
 		const std::vector<MaterialParameters*>& materialsParameters,
 		const std::vector<OBB>& colliders,
+		BoundingVolumeHierarchy* collidersHierarchy,
+		TriangleMeshHierarchy* trianglesHierarchy,
 		Skeleton* skeleton);
 	virtual ~SolidMesh();
 
 	void render(BaseMaterial* baseMaterial);
+	void render(BaseMaterial* baseMaterial, const std::vector<matrix4>& matrixPalette);
 
-	std::vector<OBB> getColliders() const;
+	// Per-instance data is expected to be passed to the GPU program by the caller
+	void renderInstanced(BaseMaterial* baseMaterial, size_t instancesCount);
+
+	const std::vector<OBB>& getColliders() const;
+
+	// Hierarchy over the colliders bounds, indices refer to getColliders().
+	// It is built on creation if the mesh file doesn't contain it
+	const BoundingVolumeHierarchy* getCollidersHierarchy() const;
+
+	// Hierarchy over the render triangles for the precise ray queries, null for the skinned meshes
+	const TriangleMeshHierarchy* getTrianglesHierarchy() const;
 
 	bool hasSkeleton() const;
 	Skeleton* getSkeleton() const;
 
+protected:
+	void uploadDualQuaternionsPalette(GpuProgram* gpuProgram, const std::vector<matrix4>& matrixPalette);
+
+	void renderGeometry(BaseMaterial* baseMaterial, size_t instancesCount);
+
 protected:
 	std::vector<size_t> m_groupsOffsets;
 	GeometryStore* m_geometry;
 
 	std::vector<MaterialParameters*> m_materialsParameters;
 	std::vector<OBB> m_colliders;
+	BoundingVolumeHierarchy* m_collidersHierarchy;
+	TriangleMeshHierarchy* m_trianglesHierarchy;
 
 	Skeleton* m_skeleton;
+
+	// Conversion buffer for the dual quaternion skinning, two vectors per bone
+	std::vector<vector4> m_dualQuaternionsPalette;
 };
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "SolidMesh.h"
 
 #include <fstream>
+#include <algorithm>
 
 SolidMeshLoader::SolidMeshLoader(ResourceManager * resourceManager, GraphicsResourceFactory* graphicsResourceFactory)
 	: m_resourceManager(resourceManager), m_graphicsResourceFactory(graphicsResourceFactory)
@@ -126,6 +127,12 @@ Resource * SolidMeshLoader::load(const std::string & filename)
 			skeleton = new Skeleton(bones, skeletonDescription.globalInverseTransform);
 		}
 
+		// Colliders hierarchy
+		BoundingVolumeHierarchy* collidersHierarchy = nullptr;
+
+		if (header.version >= SOLID_MESH_FORMAT_COLLIDERS_HIERARCHY_VERSION)
+			collidersHierarchy = readCollidersHierarchy(in, colliders, filename);
+
 		GeometryStore* geometryStore = nullptr;
 
 		geometryStore = m_graphicsResourceFactory->createGeometryStore();
@@ -211,7 +218,13 @@ Resource * SolidMeshLoader::load(const std::string & filename)
 
 		geometryStore->create();
 
-		return new SolidMesh(geometryStore, partsOffsets, connectedMaterialsParameters, colliders, skeleton);
+		// Skinned meshes are deformed on the GPU, so their bind pose triangles are useless for ray queries
+		TriangleMeshHierarchy* trianglesHierarchy = nullptr;
+
+		if (!description.hasSkeleton)
+			trianglesHierarchy = new TriangleMeshHierarchy(positions, indices);
+
+		return new SolidMesh(geometryStore, partsOffsets, connectedMaterialsParameters, colliders, collidersHierarchy, trianglesHierarchy, skeleton);
 	}
 	catch (const std::ifstream::failure& failture) {
 		throw ResourceLoadingException(ResourceLoadingError::InvalidData, filename.c_str(), failture.what(), __FILE__, __LINE__, __FUNCTION__);
@@ -224,6 +237,82 @@ Resource * SolidMeshLoader::load(const std::string & filename)
 	}
 }
 
+BoundingVolumeHierarchy * SolidMeshLoader::readCollidersHierarchy(std::ifstream & in, const std::vector<OBB>& colliders, 
+	const std::string& filename)
+{
+	CollidersHierarchyDescription hierarchyDescription = { 0, 0 };
+
+	// The section is optional, the hierarchy is built at runtime without it
+	if (!in.read((char*)&hierarchyDescription, sizeof hierarchyDescription) || hierarchyDescription.nodesCount == 0)
+		return nullptr;
+
+	if (hierarchyDescription.collidersIndicesCount != colliders.size())
+		throw ResourceLoadingException(ResourceLoadingError::InvalidData, filename.c_str(), "Colliders hierarchy doesn't match the colliders", __FILE__, __LINE__, __FUNCTION__);
+
+	std::vector<CollidersHierarchyNodeDescription> nodesDescriptions(hierarchyDescription.nodesCount);
+	in.read((char*)nodesDescriptions.data(), sizeof(CollidersHierarchyNodeDescription) * hierarchyDescription.nodesCount);
+
+	if (!in)
+		throw ResourceLoadingException(ResourceLoadingError::InvalidData, filename.c_str(), "Colliders hierarchy nodes are truncated", __FILE__, __LINE__, __FUNCTION__);
+
+	std::vector<uint32> collidersIndices(hierarchyDescription.collidersIndicesCount);
+	in.read((char*)collidersIndices.data(), sizeof(uint32) * hierarchyDescription.collidersIndicesCount);
+
+	if (!in)
+		throw ResourceLoadingException(ResourceLoadingError::InvalidData, filename.c_str(), "Colliders hierarchy indices are truncated", __FILE__, __LINE__, __FUNCTION__);
+
+	std::vector<BoundingVolumeHierarchy::Node> nodes;
+	nodes.reserve(nodesDescriptions.size());
+
+	// Children follow their parents, so the depth of a node is known when it's reached.
+	// The queries traverse the hierarchy with a fixed stack
+	std::vector<size_t> nodesDepths(nodesDescriptions.size(), 0);
+
+	for (const CollidersHierarchyNodeDescription& nodeDescription : nodesDescriptions) {
+		bool isLeaf = nodeDescription.collidersCount > 0;
+		size_t nodeIndex = nodes.size();
+
+		bool isValidNode = isLeaf ? 
+			(nodeDescription.firstColliderIndex <= collidersIndices.size() && 
+				nodeDescription.collidersCount <= collidersIndices.size() - nodeDescription.firstColliderIndex) :
+			(nodeDescription.secondChildIndex > nodeIndex + 1 && nodeDescription.secondChildIndex < nodesDescriptions.size());
+
+		if (!isValidNode)
+			throw ResourceLoadingException(ResourceLoadingError::InvalidData, filename.c_str(), "Invalid colliders hierarchy node", __FILE__, __LINE__, __FUNCTION__);
+
+		if (nodesDepths[nodeIndex] >= BoundingVolumeHierarchy::MAX_TRAVERSAL_DEPTH)
+			throw ResourceLoadingException(ResourceLoadingError::InvalidData, filename.c_str(), "Colliders hierarchy is too deep", __FILE__, __LINE__, __FUNCTION__);
+
+		if (!isLeaf) {
+			size_t childDepth = nodesDepths[nodeIndex] + 1;
+
+			nodesDepths[nodeIndex + 1] = std::max(nodesDepths[nodeIndex + 1], childDepth);
+			nodesDepths[nodeDescription.secondChildIndex] = std::max(nodesDepths[nodeDescription.secondChildIndex], childDepth);
+		}
+
+		BoundingVolumeHierarchy::Node node;
+		node.bounds = AABB(nodeDescription.min, nodeDescription.max);
+		node.firstItemIndex = nodeDescription.firstColliderIndex;
+		node.itemsCount = nodeDescription.collidersCount;
+		node.secondChildIndex = nodeDescription.secondChildIndex;
+
+		nodes.push_back(node);
+	}
+
+	std::vector<AABB> collidersBounds;
+	collidersBounds.reserve(colliders.size());
+
+	for (const OBB& collider : colliders)
+		collidersBounds.push_back(collider.getBoundingBox());
+
+	for (uint32 colliderIndex : collidersIndices) {
+		if (colliderIndex >= colliders.size())
+			throw ResourceLoadingException(ResourceLoadingError::InvalidData, filename.c_str(), "Invalid colliders hierarchy collider index", __FILE__, __LINE__, __FUNCTION__);
+	}
+
+	return new BoundingVolumeHierarchy(nodes, collidersIndices, collidersBounds);
+}
+
 PhongMaterialParameters* SolidMeshLoader::processConnectedMaterial(const MaterialDescription& materialDescription)
 {
 	PhongMaterialParameters* materialParameters = new PhongMaterialParameters();
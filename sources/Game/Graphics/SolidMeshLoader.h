@@ -3,11 +3,19 @@
 #include <Engine\Components\ResourceManager\ResourceLoader.h>
 #include <Engine\Components\ResourceManager\ResourceManager.h>
 
+#include <Engine\Components\Physics\Broadphase\BoundingVolumeHierarchy.h>
+#include <Engine\Components\Physics\Colliders\OBB.h>
+
 #include <Game\Graphics\Materials\PhongMaterialParameters.h>
 
+#include <fstream>
+
 #define SOLID_MESH_LOADER_MAX_NAMES_LENGTH 256
 #define SOLID_MESH_LOADER_MAX_PATH_LENGTH 256
 
+// Files of this version and newer end with the colliders hierarchy section
+#define SOLID_MESH_FORMAT_COLLIDERS_HIERARCHY_VERSION 2
+
 class SolidMeshLoader : public ResourceLoader {
 private:
 	struct MaterialDescription {
@@ -64,6 +72,22 @@ private:
 		std::uint32_t bonesCount;
 		matrix4 globalInverseTransform;
 	};
+
+	// Flattened depth-first hierarchy, zero nodes count means that the exporter didn't build it
+	struct CollidersHierarchyDescription {
+		std::uint32_t nodesCount;
+		std::uint32_t collidersIndicesCount;
+	};
+
+	struct CollidersHierarchyNodeDescription {
+		vector3 min;
+		vector3 max;
+
+		std::uint32_t firstColliderIndex;
+		std::uint32_t collidersCount;
+
+		std::uint32_t secondChildIndex;
+	};
 public:
 	SolidMeshLoader(ResourceManager* resourceManager, GraphicsResourceFactory* graphicsResourceFactory);
 	virtual ~SolidMeshLoader();
@@ -74,6 +98,9 @@ private:
 	PhongMaterialParameters* processConnectedMaterial(const MaterialDescription& materialDescription);
 	Texture* processConnectedTexture(const std::string& filename);
 
+	BoundingVolumeHierarchy* readCollidersHierarchy(std::ifstream& in, const std::vector<OBB>& colliders, 
+		const std::string& filename);
+
 private:
 	ResourceManager* m_resourceManager;
 	GraphicsResourceFactory* m_graphicsResourceFactory;
@@ -1,5 +1,6 @@
 #include "LevelScene.h"
 
+#include <Engine\Engine.h>
 #include <Engine\Utils\time.h>
 #include <Engine\Components\Math\Random.h>
 #include <Engine\Utils\string.h>
@@ -25,7 +26,10 @@ LevelScene::LevelScene(GraphicsContext* graphicsContext,
 	m_levelRenderer(nullptr),
 	m_phongLightingBaseMaterial(nullptr),
 	m_gameObjectsStore(new GameObjectsStore()),
-	m_levelGUILayout(new GUILayout())
+	m_levelGUILayout(new GUILayout()),
+	m_animationSystem(nullptr),
+	m_physicsWorld(new PhysicsWorld(1.0f / PHYSICS_STEPS_PER_SECOND, GetJobSystem())),
+	m_transformsInterpolator(new TransformsInterpolator())
 {
 	m_levelGUILayout->setPosition(0, 0);
 	m_levelGUILayout->setSize(m_graphicsContext->getViewportWidth(), m_graphicsContext->getViewportHeight());
@@ -33,6 +37,12 @@ LevelScene::LevelScene(GraphicsContext* graphicsContext,
 
 	loadResources();
 
+	m_animationSystem = new AnimationSystem(GetJobSystem());
+
+	// Level is placed at the origin, so the colliders are already in the world space
+	m_physicsWorld->setStaticGeometry(&m_levelMesh->getColliders(), 
+		m_levelMesh->getCollidersHierarchy(), m_levelMesh->getTrianglesHierarchy());
+
 	m_levelRenderer = new LevelRenderer(graphicsContext, graphicsResourceFactory, m_deferredLightingProgram);
 
 	m_gameObjectsStore->setRemoveObjectCallback(
@@ -89,9 +99,16 @@ LevelScene::~LevelScene()
 	delete m_freeCameraController;
 
 	delete m_boxPrimitive;
+
+	delete m_animationSystem;
+
+	delete m_physicsWorld;
+	delete m_transformsInterpolator;
 }
 
 void LevelScene::update() {
+	m_transformsInterpolator->savePreviousStates();
+
 	if (m_hud->isControlLocked())
 		return;
 	
@@ -100,56 +117,23 @@ void LevelScene::update() {
 	}
 
 	if (m_infoportionsStore->hasInfoportion("task_intro_room_leaved")) {
-		m_winText->show();
+		GetJobSystem()->runOnMainThread([this]() { m_winText->show(); });
 		return;
 	}
 
 	m_timeManager->update();
 	m_activeInputController->update();
 	m_hud->update();
-	m_gameObjectsStore->update();
-
-	OBB newPlayerObb = m_player->getWorldPlacedCollider();
 
-	Intersection intersection;
+	m_animationSystem->update(1.0f / GAME_STATE_UPDATES_PER_SECOND);
 
-	for (const OBB& obb : m_levelMesh->getColliders()) {
-		if (newPlayerObb.intersects(obb, intersection)) {
-			m_player->getTransform()->move(intersection.getDirection() * intersection.getDepth());
-		}
-	}
-
-	if (m_levelDoor != nullptr) {
-		if (newPlayerObb.intersects(OBB(m_levelDoor->getColliders()[0], m_levelDoor->getTransform()->getTransformationMatrix()), intersection)) {
-			m_player->getTransform()->move(intersection.getDirection() * intersection.getDepth());
-		}
-	}
-
-	Ray downRay(m_player->getTransform()->getPosition(), vector3(0.0f, -1.0f, 0.0f));
-	float distance = 0.0f;
-
-	float minDistance = std::numeric_limits<float>::infinity();
-	for (const OBB& obb : m_levelMesh->getColliders()) {
-		bool isFloorIntersects = obb.intersects(downRay, distance);
-
-		if (isFloorIntersects) {
-			minDistance = std::min(minDistance, distance);
-		}
-	}
-
-	if (minDistance >= 1.4f) {
-		vector3 oldPosition = m_player->getTransform()->getPosition();
-
-		oldPosition.y -= 0.30f;
-		oldPosition.y = std::max(oldPosition.y, 1.4f);
-
-		m_player->getTransform()->setPosition(oldPosition);
-	}
+	m_physicsWorld->update(1.0f / GAME_STATE_UPDATES_PER_SECOND);
 
+	m_gameObjectsStore->updateInteractiveObjects();
 
 	Bone* head = m_player->getSkeleton()->getBone("HumanHead");
 
-	const matrix4& headBoneLocal = head->getCurrentPoseTransform();
+	const matrix4& headBoneLocal = m_player->getAnimator()->getMatrixPalette()[head->getId()];
 	vector3 boneWorldPosition = m_player->getTransform()->getTransformationMatrix() * vector4(vector3(headBoneLocal[3]), 1.0f);
 
 	m_playerCamera->getTransform()->setOrientation(m_player->getTransform()->getOrientation());
@@ -158,6 +142,18 @@ void LevelScene::update() {
 
 }
 
+void LevelScene::prepareRendering(float interpolationFactor)
+{
+	m_transformsInterpolator->applyInterpolation(interpolationFactor);
+	m_gameObjectsStore->updateTransforms();
+
+	m_levelRenderer->prepareRendering();
+	m_transformsInterpolator->restoreCurrentStates();
+
+	// Removed objects are deleted only now, the previous frame could still render them
+	m_gameObjectsStore->update();
+}
+
 void LevelScene::render()
 {
 	m_levelRenderer->render();
@@ -167,6 +163,7 @@ void LevelScene::setActiveCamera(Camera * camera)
 {
 	Scene::setActiveCamera(camera);
 	m_levelRenderer->setActiveCamera(camera);
+	m_animationSystem->setViewer(camera);
 }
 
 void LevelScene::activate()
@@ -221,8 +218,9 @@ void LevelScene::initializeSceneObjects() {
 	std::string bookTitle = " ";
 	std::string bookText = "Lorem ipsum dolor sit amet, consectetur adipiscing\nelit, sed do eiusmod tempor incididunt ut labore et dolore\nmagna aliqua. Ut enim ad minim veniam, quis nostrud exercitation\nullamco laboris nisi ut aliquip";
 
-	Book* book = new Book(m_resourceManager->getResource<SolidMesh>("meshes_dynamic_book"),
-		m_phongLightingBaseMaterial, m_resourceManager->getResource<Texture>("textues_dynamic_book_icon"), bookTitle, bookText);
+	Book* book = m_gameObjectsStore->createGameObject<Book>(m_gameObjectsStore->createTransform(),
+		m_resourceManager->getResource<SolidMesh>("meshes_dynamic_book"), m_phongLightingBaseMaterial,
+		m_resourceManager->getResource<Texture>("textues_dynamic_book_icon"), bookTitle, bookText);
 	book->getTransform()->setPosition(-2.60989, 1.18929, -2.3509);
 
 	book->setGameObjectUsage(GameObject::Usage::DynamicObject);
@@ -241,8 +239,9 @@ void LevelScene::initializeSceneObjects() {
 	std::string book2Title = "- ";
 	std::string book2Text = "Hello, world!\nHello, world in new line!";
 
-	Book* book2 = new Book(m_resourceManager->getResource<SolidMesh>("meshes_dynamic_book"),
-		m_phongLightingBaseMaterial, m_resourceManager->getResource<Texture>("textues_dynamic_book_icon"), book2Title, book2Text);
+	Book* book2 = m_gameObjectsStore->createGameObject<Book>(m_gameObjectsStore->createTransform(),
+		m_resourceManager->getResource<SolidMesh>("meshes_dynamic_book"), m_phongLightingBaseMaterial,
+		m_resourceManager->getResource<Texture>("textues_dynamic_book_icon"), book2Title, book2Text);
 	book2->getTransform()->setPosition(-2.60989, 1.18929, -1.3509);
 
 	book2->setGameObjectUsage(GameObject::Usage::DynamicObject);
@@ -251,10 +250,12 @@ void LevelScene::initializeSceneObjects() {
 	book2->setGameObjectInteractiveTitle(book2Title);
 
 	// Initialize level
-	m_level = new SolidGameObject(m_levelMesh, m_phongLightingBaseMaterial);
+	m_level = m_gameObjectsStore->createGameObject<SolidGameObject>(m_gameObjectsStore->createTransform(),
+		m_levelMesh, m_phongLightingBaseMaterial);
 	m_level->setGameObjectUsage(GameObject::Usage::StaticEnvironmentObject);
 
-	m_levelDoor = new LockedDoor(m_resourceManager->getResource<SolidMesh>("meshes_dynamic_door"), m_phongLightingBaseMaterial, m_timeManager);
+	m_levelDoor = m_gameObjectsStore->createGameObject<LockedDoor>(m_gameObjectsStore->createTransform(),
+		m_resourceManager->getResource<SolidMesh>("meshes_dynamic_door"), m_phongLightingBaseMaterial, m_timeManager);
 	m_levelDoor->setGameObjectInteractiveTitle("");
 	m_levelDoor->getTransform()->setPosition(-1.316f, 1.752f, -4.66f);
 
@@ -271,7 +272,7 @@ void LevelScene::initializeSceneObjects() {
 	);
 
 	// Initialize lights
-	Light* whileLight = new Light(Light::Type::Point);
+	Light* whileLight = m_gameObjectsStore->createGameObject<Light>(Light::Type::Point);
 	whileLight->setColor(vector3(1.0f, 1.0f, 1.0f));
 	whileLight->setAmbientIntensity(0.002f);
 	whileLight->setDiffuseIntensity(0.86f);
@@ -305,10 +306,17 @@ void LevelScene::initializePrimitives()
 void LevelScene::initializePlayer()
 {
 	// Player initialization
-	m_player = new Player(m_playerMesh, m_phongLightingBaseMaterial);
+	m_player = m_gameObjectsStore->createGameObject<Player>(m_gameObjectsStore->createTransform(),
+		m_playerMesh, m_phongLightingBaseMaterial);
 	m_player->getTransform()->setPosition(-0.25916, 1.40000, 0.4456);
 	m_player->getTransform()->setOrientation(quaternion(-0.6608, 0.22277, 0.67916, 0.22895));
 
+	// The body origin is at the eyes level, so the floor is at the player height below it
+	RigidBody* playerBody = m_physicsWorld->createRigidBody(RigidBody::Type::Dynamic, m_player->getTransform(), m_playerMesh->getColliders());
+	playerBody->setFloorDistance(1.4f);
+
+	m_player->setRigidBody(playerBody);
+
 	m_playerCamera = createCamera("playerCamera");
 	m_playerCamera->setNearClipDistance(0.1f);
 	m_playerCamera->setFarClipDistance(300.0f);
@@ -316,6 +324,9 @@ void LevelScene::initializePlayer()
 	m_playerCamera->setAspectRatio((float)m_graphicsContext->getViewportWidth() / m_graphicsContext->getViewportHeight());
 	m_playerCamera->getTransform()->fixYAxis();
 
+	m_transformsInterpolator->addTransform(m_player->getTransform());
+	m_transformsInterpolator->addTransform(m_playerCamera->getTransform());
+
 	Animation* playerArmsIdle = m_resourceManager->getResource<Animation>("animations_player_arms_idle");
 	playerArmsIdle->setEndBehaviour(Animation::EndBehaviour::Repeat);
 
@@ -336,6 +347,8 @@ void LevelScene::initializePlayer()
 		m_inputManager, playerAnimations, m_gameObjectsStore, m_hud, m_graphicsResourceFactory);
 
 	m_playerController->setMovementSpeed(0.15f);
+
+	m_animationSystem->registerAnimator(m_player->getAnimator());
 }
 
 void LevelScene::initializeFreeCamera()
@@ -352,6 +365,8 @@ void LevelScene::initializeFreeCamera()
 	m_freeCamera->getTransform()->lookAt(0.0f, 0.0f, 10.0f);
 
 	m_freeCameraController = new FreeCameraController(m_freeCamera, m_inputManager);
+
+	m_transformsInterpolator->addTransform(m_freeCamera->getTransform());
 }
 
 void LevelScene::initializeInfoportions()
@@ -429,38 +444,46 @@ void LevelScene::changeCurrentTaskCallback(const Task * newCurrentTask)
 
 void LevelScene::removeGameObjectCallback(GameObject * object)
 {
+	EntityManager* entityManager = m_gameObjectsStore->getEntityManager();
+
 	switch (object->getGameObjectUsage()) {
 	case GameObject::Usage::LightSource:
-		m_levelRenderer->removeLightSource(dynamic_cast<Light*>(object));
+		m_levelRenderer->removeLightSource(entityManager->getComponent<LightComponent>(object->getEntity())->light);
 		break;
 
 	case GameObject::Usage::StaticEnvironmentObject:
 	case GameObject::Usage::Player:
-		m_levelRenderer->removeRenderableObject(dynamic_cast<Renderable*>(object));
+		m_levelRenderer->removeRenderableObject(entityManager->getComponent<MeshComponent>(object->getEntity())->renderable);
 		break;
 
 	case GameObject::Usage::DynamicObject:
-		if (object->isLocatedInWorld())
-			m_levelRenderer->removeRenderableObject(dynamic_cast<Renderable*>(object));
+		if (object->isLocatedInWorld()) {
+			m_levelRenderer->removeRenderableObject(entityManager->getComponent<MeshComponent>(object->getEntity())->renderable);
+			removeDynamicCollider(object);
+		}
 		break;
 	}
 }
 
 void LevelScene::registerGameObjectCallback(GameObject * object)
 {
+	EntityManager* entityManager = m_gameObjectsStore->getEntityManager();
+
 	switch (object->getGameObjectUsage()) {
 	case GameObject::Usage::LightSource:
-		m_levelRenderer->registerLightSource(dynamic_cast<Light*>(object));
+		m_levelRenderer->registerLightSource(entityManager->getComponent<LightComponent>(object->getEntity())->light);
 		break;
 
 	case GameObject::Usage::StaticEnvironmentObject:
 	case GameObject::Usage::Player:
-		m_levelRenderer->addRenderableObject(dynamic_cast<Renderable*>(object));
+		m_levelRenderer->addRenderableObject(entityManager->getComponent<MeshComponent>(object->getEntity())->renderable);
 		break;
 
 	case GameObject::Usage::DynamicObject:
-		if (object->isLocatedInWorld())
-			m_levelRenderer->addRenderableObject(dynamic_cast<Renderable*>(object));
+		if (object->isLocatedInWorld()) {
+			m_levelRenderer->addRenderableObject(entityManager->getComponent<MeshComponent>(object->getEntity())->renderable);
+			addDynamicCollider(object);
+		}
 		break;
 	}
  }
@@ -468,15 +491,50 @@ void LevelScene::registerGameObjectCallback(GameObject * object)
 void LevelScene::relocateGameObjectCallback(GameObject * object, GameObject::Location oldLocation, GameObject::Location newLocation)
 {
 	if (object->getGameObjectUsage() == GameObject::Usage::DynamicObject) {
-		if (oldLocation == GameObject::Location::World && newLocation == GameObject::Location::Inventory)
-			m_levelRenderer->removeRenderableObject(dynamic_cast<Renderable*>(object));
+		Renderable* renderable = m_gameObjectsStore->getEntityManager()->getComponent<MeshComponent>(object->getEntity())->renderable;
 
-		if (oldLocation == GameObject::Location::Inventory && newLocation == GameObject::Location::World)
-			m_levelRenderer->addRenderableObject(dynamic_cast<Renderable*>(object));
+		if (oldLocation == GameObject::Location::World && newLocation == GameObject::Location::Inventory) {
+			m_levelRenderer->removeRenderableObject(renderable);
+			removeDynamicCollider(object);
+		}
+
+		if (oldLocation == GameObject::Location::Inventory && newLocation == GameObject::Location::World) {
+			m_levelRenderer->addRenderableObject(renderable);
+			addDynamicCollider(object);
+		}
 
 	}
 }
 
+void LevelScene::addDynamicCollider(GameObject * object)
+{
+	EntityManager* entityManager = m_gameObjectsStore->getEntityManager();
+	ColliderComponent* collider = entityManager->getComponent<ColliderComponent>(object->getEntity());
+
+	if (collider == nullptr || collider->colliders->empty())
+		return;
+
+	Transform* transform = entityManager->getComponent<TransformComponent>(object->getEntity())->transform;
+
+	m_dynamicObjectsBodies[object] = m_physicsWorld->createRigidBody(RigidBody::Type::Kinematic, 
+		transform, *collider->colliders);
+
+	m_transformsInterpolator->addTransform(transform);
+}
+
+void LevelScene::removeDynamicCollider(GameObject * object)
+{
+	auto bodyIt = m_dynamicObjectsBodies.find(object);
+
+	if (bodyIt == m_dynamicObjectsBodies.end())
+		return;
+
+	m_physicsWorld->destroyRigidBody(bodyIt->second);
+	m_transformsInterpolator->removeTransform(bodyIt->first->getTransform());
+
+	m_dynamicObjectsBodies.erase(bodyIt);
+}
+
 void LevelScene::changeCameraCommandHandler(Console * console, const std::vector<std::string>& args)
 {
 	if (args.empty())
@@ -7,6 +7,9 @@
 #include <Game\Graphics\Primitives\BoxPrimitive.h>
 #include <Game\Graphics\Animation\Animation.h>
 #include <Game\Graphics\Animation\Animator.h>
+#include <Game\Graphics\Animation\AnimationSystem.h>
+#include <Engine\Components\Physics\PhysicsWorld.h>
+#include <Engine\Components\Math\TransformsInterpolator.h>
 #include <Game\Console\Console.h>
 
 #include <Game\Graphics\LevelRenderer.h>
@@ -27,6 +30,8 @@
 #include "PlayerController.h"
 #include "FreeCameraController.h"
 
+#include <unordered_map>
+
 class LevelScene : public Scene, public InputEventsListener {
 public:
 	LevelScene(GraphicsContext* graphicsContext, 
@@ -39,6 +44,7 @@ public:
 	virtual ~LevelScene();
 
 	virtual void update() override;
+	virtual void prepareRendering(float interpolationFactor) override;
 	virtual void render() override;
 
 	virtual void setActiveCamera(Camera* camera);
@@ -65,6 +71,9 @@ private:
 	void registerGameObjectCallback(GameObject* object);
 	void relocateGameObjectCallback(GameObject* object, GameObject::Location oldLocation, GameObject::Location newLocation);
 
+	void addDynamicCollider(GameObject* object);
+	void removeDynamicCollider(GameObject* object);
+
 	void changeCameraCommandHandler(Console* console, const std::vector<std::string>& args);
 	void changeGammaCorrectionCommandHandler(Console* console, const std::vector<std::string>& args);
 	void pickPositionCommandHandler(Console* console, const std::vector<std::string>& args);
@@ -87,6 +96,18 @@ protected:
 
 	LevelRenderer * m_levelRenderer;
 
+protected:
+	AnimationSystem* m_animationSystem;
+
+protected:
+	PhysicsWorld* m_physicsWorld;
+
+	// Kinematic bodies of the dynamic objects with colliders, which are placed in the world
+	std::unordered_map<GameObject*, RigidBody*> m_dynamicObjectsBodies;
+
+	// Moving transforms are rendered between their last two updated states
+	TransformsInterpolator* m_transformsInterpolator;
+
 protected:
 	std::vector<Light*> m_lights;
 
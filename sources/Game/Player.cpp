@@ -2,30 +2,43 @@
 
 #include <Engine\assertions.h>
 
-Player::Player(SolidMesh * armsMesh, BaseMaterial* baseMaterial)
+Player::Player(Transform* transform, SolidMesh * armsMesh, BaseMaterial* baseMaterial)
 	: Renderable(baseMaterial),
 	m_armsMesh(armsMesh), 
-	m_transform(new Transform()),
-	m_inventory(new Inventory())
+	m_transform(transform),
+	m_animator(nullptr),
+	m_inventory(new Inventory()),
+	m_rigidBody(nullptr),
+	m_renderedTransformationMatrix(1.0f)
 {
 	_assert(m_armsMesh->getColliders().size() == 1);
 	_assert(m_armsMesh->hasSkeleton());
 
+	m_animator = new Animator(m_armsMesh->getSkeleton());
+
 	setGameObjectUsage(GameObject::Usage::Player);
 }
 
 Player::~Player()
 {
-	delete m_transform;
+	delete m_animator;
 	delete m_inventory;
 }
 
+void Player::prepareRendering()
+{
+	m_renderedTransformationMatrix = m_transform->getTransformationMatrix();
+
+	// Capacity is kept, so the copy doesn't allocate after the first frame
+	m_renderedMatrixPalette = m_animator->getMatrixPalette();
+}
+
 void Player::render()
 {
 	if (m_baseMaterial->isTransformsDataRequired())
-		m_baseMaterial->getGpuProgram()->setParameter("transform.localToWorld", m_transform->getTransformationMatrix());
+		m_baseMaterial->getGpuProgram()->setParameter("transform.localToWorld", m_renderedTransformationMatrix);
 
-	m_armsMesh->render(m_baseMaterial);
+	m_armsMesh->render(m_baseMaterial, m_renderedMatrixPalette);
 }
 
 Transform * Player::getTransform() const
@@ -40,7 +53,7 @@ OBB Player::getWorldPlacedCollider() const
 
 vector3 Player::getPosition() const
 {
-	return m_transform->getPosition();
+	return m_transform->getWorldPosition();
 }
 
 Skeleton* Player::getSkeleton() const
@@ -48,12 +61,22 @@ Skeleton* Player::getSkeleton() const
 	return m_armsMesh->getSkeleton();
 }
 
-void Player::applyPose(const SkeletonPose & pose)
+Animator * Player::getAnimator() const
 {
-	m_armsMesh->getSkeleton()->applyPose(pose);
+	return m_animator;
 }
 
 Inventory * Player::getInventory() const
 {
 	return m_inventory;
 }
+
+void Player::setRigidBody(RigidBody * rigidBody)
+{
+	m_rigidBody = rigidBody;
+}
+
+RigidBody * Player::getRigidBody() const
+{
+	return m_rigidBody;
+}
@@ -3,28 +3,41 @@
 #include "GameObject.h"
 #include <Game\Graphics\SolidMesh.h>
 #include <Game\Graphics\Renderable.h>
+#include <Game\Graphics\Animation\Animator.h>
+#include <Engine\Components\Physics\RigidBody.h>
 
 #include <Game\Game\Inventory\Inventory.h>
 
 class Player : public GameObject, public Renderable {
 public:
-	Player(SolidMesh* armsMesh, BaseMaterial* baseMaterial);
+	// The transform is owned by the objects store
+	Player(Transform* transform, SolidMesh* armsMesh, BaseMaterial* baseMaterial);
 	virtual ~Player();
 
+	virtual void prepareRendering() override;
 	virtual void render() override;
-	Transform* getTransform() const;
+	Transform* getTransform() const override;
 
 	OBB getWorldPlacedCollider() const;
 	vector3 getPosition() const override;
 
 	Skeleton* getSkeleton() const;
-
-	void applyPose(const SkeletonPose& pose);
+	Animator* getAnimator() const;
 
 	Inventory* getInventory() const;
+
+	// The body is owned by the physics world
+	void setRigidBody(RigidBody* rigidBody);
+	RigidBody* getRigidBody() const;
 private:
 	Transform * m_transform;
 	SolidMesh* m_armsMesh;
+	Animator* m_animator;
 
 	Inventory* m_inventory;
+
+	RigidBody* m_rigidBody;
+
+	matrix4 m_renderedTransformationMatrix;
+	std::vector<matrix4> m_renderedMatrixPalette;
 };
\ No newline at end of file
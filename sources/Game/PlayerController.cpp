@@ -11,7 +11,6 @@ PlayerController::PlayerController(Player * player, Camera * camera, InputManage
 	m_player(player), 
 	m_playerCamera(camera), 
 	m_statesAnimations(statesAnimations),
-	m_playerAnimator(nullptr),
 	m_gameObjectsStore(gameObjectsStore),
 	m_hud(hud),
 	m_graphicsResourceFactory(graphicsResourceFactory)
@@ -23,14 +22,12 @@ PlayerController::PlayerController(Player * player, Camera * camera, InputManage
 
 	m_player->getTransform()->fixYAxis();
 
-	m_playerAnimator = new Animator(m_player->getSkeleton());
 	changeState(PlayerState::Idle);
-	m_playerAnimator->play();
+	m_player->getAnimator()->play();
 }
 
 PlayerController::~PlayerController()
 {
-	delete m_playerAnimator;
 	delete m_inventoryViewer;
 }
 
@@ -41,24 +38,23 @@ void PlayerController::update() {
 
 	MousePosition mousePosition = m_inputManager->getMousePosition();
 
-	vector3 position = m_player->getTransform()->getPosition();
-	float oldY = position.y;
+	vector3 movement(0.0f);
 
 	if (m_inputManager->isKeyPressed(GLFW_KEY_W)) {
-		position += m_player->getTransform()->getFrontDirection() * m_movementSpeed;
+		movement += m_player->getTransform()->getFrontDirection() * m_movementSpeed;
 		needMove = true;
 	}
 	else if (m_inputManager->isKeyPressed(GLFW_KEY_S)) {
-		position -= m_player->getTransform()->getFrontDirection() * m_movementSpeed;
+		movement -= m_player->getTransform()->getFrontDirection() * m_movementSpeed;
 		needMove = true;
 	}
 
 	if (m_inputManager->isKeyPressed(GLFW_KEY_A)) {
-		position -= m_player->getTransform()->getRightDirection() * m_movementSpeed;
+		movement -= m_player->getTransform()->getRightDirection() * m_movementSpeed;
 		needMove = true;
 	}
 	else if (m_inputManager->isKeyPressed(GLFW_KEY_D)) {
-		position += m_player->getTransform()->getRightDirection() * m_movementSpeed;
+		movement += m_player->getTransform()->getRightDirection() * m_movementSpeed;
 		needMove = true;
 	}
 
@@ -68,10 +64,12 @@ void PlayerController::update() {
 	if ((pitchOffset > 0 && currentPitchAngle - pitchOffset > 0.001) || (pitchOffset < 0 && currentPitchAngle - pitchOffset < 179.999))
 		m_player->getTransform()->pitch(pitchOffset);
 
-	position.y = oldY;
+	movement.y = 0.0f;
 
 	m_player->getTransform()->yaw(m_mouseSensitivity * mousePosition.x * -1.0f);
-	m_player->getTransform()->setPosition(position);
+
+	// The position is changed by the physics world on its next steps
+	m_player->getRigidBody()->move(movement);
 
 	if (needMove && m_currentPlayerState != PlayerState::Running)
 		changeState(PlayerState::Running);
@@ -171,14 +169,14 @@ void PlayerController::useObject(GameObject * object)
 
 void PlayerController::updateAnimation()
 {
-	if (m_currentPlayerState == PlayerState::Taking && m_playerAnimator->isStopped()) {
+	// Animation time and pose are advanced by the scene animation system,
+	// only the state transitions are handled here
+	Animator* playerAnimator = m_player->getAnimator();
+
+	if (m_currentPlayerState == PlayerState::Taking && playerAnimator->isStopped()) {
 		changeState(PlayerState::Idle);
-		m_playerAnimator->play();
+		playerAnimator->play();
 	}
-
-	m_playerAnimator->increaseAnimationTime(1.0f / GAME_STATE_UPDATES_PER_SECOND);
-
-	m_player->applyPose(m_playerAnimator->getAnimatedPose());
 }
 
 void PlayerController::checkInteractiveObjects()
@@ -203,21 +201,14 @@ void PlayerController::checkInteractiveObjects()
 
 GameObject * PlayerController::findNearestInteractiveObject() const
 {
-	for (GameObject* gameObject : m_gameObjectsStore->getObjects()) {
-		if (!gameObject->isInteractive() || !gameObject->isLocatedInWorld())
-			continue;
-
-		vector3 distanceVector = gameObject->getPosition() - m_player->getPosition();
-
-		if (glm::length(distanceVector) <= 1.4f &&
-			glm::degrees(glm::angle(distanceVector, m_player->getTransform()->getFrontDirection())) <= 20.0f)
-		{
-			return gameObject;
-		}
-	}
+	FrameVector<GameObject*> interactiveObjects;
+	m_gameObjectsStore->findInteractiveObjects(m_player->getPosition(), m_player->getTransform()->getFrontDirection(),
+		1.4f, 20.0f, interactiveObjects);
 
+	if (interactiveObjects.empty())
+		return nullptr;
 
-	return nullptr;
+	return interactiveObjects.front();
 }
 
 void PlayerController::changeState(PlayerState state)
@@ -225,5 +216,5 @@ void PlayerController::changeState(PlayerState state)
 	m_currentPlayerState = state;
 
 	Animation* newStateAnimation = m_statesAnimations[(size_t)state];
-	m_playerAnimator->setCurrentAnimation(newStateAnimation);
+	m_player->getAnimator()->setCurrentAnimation(newStateAnimation);
 }
@@ -61,7 +61,6 @@ private:
 	float m_mouseSensitivity = 0.15f;
 
 	std::vector<Animation*> m_statesAnimations;
-	Animator* m_playerAnimator;
 private:
 	GameObjectsStore * m_gameObjectsStore;
 
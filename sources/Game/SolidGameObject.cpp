@@ -1,10 +1,11 @@
 #include "SolidGameObject.h"
 
-SolidGameObject::SolidGameObject(SolidMesh* mesh, BaseMaterial* baseMaterial)
+SolidGameObject::SolidGameObject(Transform* transform, SolidMesh* mesh, BaseMaterial* baseMaterial)
 	: GameObject(), 
 	Renderable(baseMaterial),
 	m_mesh(mesh), 
-	m_transform(new Transform())
+	m_transform(transform),
+	m_renderedTransformationMatrix(1.0f)
 {
 	m_transform->setPosition(0, 0, 0);
 	m_transform->setOrientation(quaternion());
@@ -13,12 +14,15 @@ SolidGameObject::SolidGameObject(SolidMesh* mesh, BaseMaterial* baseMaterial)
 
 SolidGameObject::~SolidGameObject()
 {
-	delete m_transform;
+}
+
+void SolidGameObject::prepareRendering() {
+	m_renderedTransformationMatrix = m_transform->getTransformationMatrix();
 }
 
 void SolidGameObject::render() {
 	if (m_baseMaterial->isTransformsDataRequired())
-		m_baseMaterial->getGpuProgram()->setParameter("transform.localToWorld", m_transform->getTransformationMatrix());
+		m_baseMaterial->getGpuProgram()->setParameter("transform.localToWorld", m_renderedTransformationMatrix);
 
 	m_mesh->render(m_baseMaterial);
 }
@@ -28,12 +32,12 @@ Transform * SolidGameObject::getTransform() const
 	return m_transform;
 }
 
-std::vector<OBB> SolidGameObject::getColliders() const
+const std::vector<OBB>& SolidGameObject::getColliders() const
 {
 	return m_mesh->getColliders();
 }
 
 vector3 SolidGameObject::getPosition() const
 {
-	return m_transform->getPosition();
+	return m_transform->getWorldPosition();
 }
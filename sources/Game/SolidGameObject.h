@@ -6,14 +6,16 @@
 
 class SolidGameObject : public GameObject, public Renderable {
 public:
-	SolidGameObject(SolidMesh* mesh, BaseMaterial* baseMaterial);
+	// The transform is owned by the objects store
+	SolidGameObject(Transform* transform, SolidMesh* mesh, BaseMaterial* baseMaterial);
 	virtual ~SolidGameObject();
 
+	virtual void prepareRendering() override;
 	virtual void render() override;
 
-	Transform* getTransform() const;
+	Transform* getTransform() const override;
 
-	std::vector<OBB> getColliders() const;
+	const std::vector<OBB>& getColliders() const;
 
 	vector3 getPosition() const override;
 protected:
@@ -21,4 +23,6 @@ protected:
 	SolidMesh* m_mesh;
 
 	GpuProgram* m_gpuProgram;
+
+	matrix4 m_renderedTransformationMatrix;
 };
\ No newline at end of file
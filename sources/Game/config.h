@@ -1,4 +1,17 @@
 #pragma once
 
 // Updates Per Second
-#define GAME_STATE_UPDATES_PER_SECOND 30
\ No newline at end of file
+#define GAME_STATE_UPDATES_PER_SECOND 30
+
+// Frames are paced by the display refresh rate, otherwise they are rendered as fast as possible
+#define RENDERING_VSYNC_ENABLED true
+
+// Game state of the next frame is updated on a worker thread while the current frame is rendered
+// from the state copied at the end of the previous updates
+#define GAME_PIPELINED_UPDATES_ENABLED false
+
+// Updates run in one frame at most, the rest of the lagging time is dropped
+#define MAX_UPDATES_PER_FRAME 5
+
+// Fixed steps of the physics simulation per second
+#define PHYSICS_STEPS_PER_SECOND 60
\ No newline at end of file